@@ -1,99 +1,85 @@
 #include "BasePizza.h"
-#include "ToppingGroup.h"
-#include "Topping.h"
-#include <iostream>
+#include "ToppingCatalog.h"
+#include "PizzaName.h"
+#include <utility>
 
 BasePizza::BasePizza(PizzaComponent* toppingComponent) 
     : toppings(toppingComponent), ownsComponent(true) {
 }
 
 BasePizza::~BasePizza() {
-    if (ownsComponent && toppings != nullptr) {
+    if (ownsComponent && toppings != nullptr && !toppings->isShared()) {
         delete toppings;
     }
 }
 
-BasePizza::BasePizza(const BasePizza& other) : ownsComponent(true) {
-    if (other.toppings != nullptr) {
-        // Deep copy the component
-        Topping* topping = dynamic_cast<Topping*>(other.toppings);
-        if (topping) {
-            this->toppings = new Topping(topping->getName());
-        } else {
-            ToppingGroup* group = dynamic_cast<ToppingGroup*>(other.toppings);
-            if (group) {
-                this->toppings = new ToppingGroup(*group);
-            } else {
-                this->toppings = nullptr;
-            }
-        }
-    } else {
-        this->toppings = nullptr;
-    }
+BasePizza::BasePizza(const BasePizza& other)
+    : toppings(copyComponent(other.toppings, MemoryResource::heap())), ownsComponent(true) {
+}
+
+BasePizza::BasePizza(BasePizza&& other) noexcept
+    : Pizza(std::move(other)), toppings(other.toppings), ownsComponent(other.ownsComponent) {
+    other.toppings = nullptr;
 }
 
 BasePizza& BasePizza::operator=(const BasePizza& other) {
     if (this != &other) {
         // Clean up existing resource
-        if (ownsComponent && toppings != nullptr) {
+        if (ownsComponent && toppings != nullptr && !toppings->isShared()) {
             delete toppings;
         }
         
         // Deep copy from other
-        if (other.toppings != nullptr) {
-            Topping* topping = dynamic_cast<Topping*>(other.toppings);
-            if (topping) {
-                this->toppings = new Topping(topping->getName());
-            } else {
-                ToppingGroup* group = dynamic_cast<ToppingGroup*>(other.toppings);
-                if (group) {
-                    this->toppings = new ToppingGroup(*group);
-                } else {
-                    this->toppings = nullptr;
-                }
-            }
-        } else {
-            this->toppings = nullptr;
-        }
-        
+        this->toppings = copyComponent(other.toppings, MemoryResource::heap());
         this->ownsComponent = true;
     }
     return *this;
 }
 
-Pizza* BasePizza::clone() const {
-    if (toppings != nullptr) {
-        // Deep copy the component
-        Topping* topping = dynamic_cast<Topping*>(toppings);
-        if (topping) {
-            return new BasePizza(new Topping(topping->getName()));
-        } else {
-            ToppingGroup* group = dynamic_cast<ToppingGroup*>(toppings);
-            if (group) {
-                return new BasePizza(new ToppingGroup(*group));
-            }
-        }
+Pizza* BasePizza::cloneInto(MemoryResource& resource) const {
+    return new (resource) BasePizza(copyComponent(toppings, resource));
+}
+
+PizzaComponent* BasePizza::copyComponent(const PizzaComponent* component, MemoryResource& resource) {
+    if (component == nullptr) {
+        return nullptr;
     }
-    return new BasePizza(nullptr);
+    
+    // Interned toppings are shared, not copied
+    if (component->isShared()) {
+        return const_cast<PizzaComponent*>(component);
+    }
+    
+    return component->cloneInto(resource);
 }
 
-double BasePizza::getPrice() {
+Money BasePizza::getPrice() {
     if (toppings != nullptr) {
+        CatalogScope scope;
         return toppings->getPrice();
     }
-    return 0.0;
+    return Money();
+}
+
+PizzaFingerprint BasePizza::getFingerprint() {
+    return toppings != nullptr ? toppings->getFingerprint() : PizzaFingerprint();
 }
 
 std::string BasePizza::getName() {
+    return renderName(*this);
+}
+
+void BasePizza::writeName(NameWriter& out) {
     if (toppings != nullptr) {
-        return toppings->getName();
+        toppings->writeName(out);
+    } else {
+        out.append("Empty Pizza");
     }
-    return "Empty Pizza";
 }
 
-void BasePizza::printPizza() {
-    std::cout << "Pizza: " << getName() << std::endl;
-    std::cout << "Price: R" << getPrice() << std::endl;
+void BasePizza::renderPizza(std::ostream& out) {
+    out << "Pizza: " << nameOf(*this) << '\n';
+    out << "Price: R" << getPrice() << '\n';
 }
 
 PizzaComponent* BasePizza::getToppings() const {
@@ -19,14 +19,23 @@ public:
     BasePizza(const BasePizza& other);
     BasePizza& operator=(const BasePizza& other);
     
-    virtual double getPrice() override;
+    // Moving takes over the toppings
+    BasePizza(BasePizza&& other) noexcept;
+    
+    virtual Money getPrice() override;
+    virtual PizzaFingerprint getFingerprint() override;
     virtual std::string getName() override;
-    virtual void printPizza() override;
+    virtual void writeName(NameWriter& out) override;
+    virtual void renderPizza(std::ostream& out) override;
     
     // Getter for the toppings component
     PizzaComponent* getToppings() const;
 
-    Pizza* clone() const override;
+    Pizza* cloneInto(MemoryResource& resource) const override;
+
+private:
+    // Copy of a component allocated from resource (shared toppings are returned as is)
+    static PizzaComponent* copyComponent(const PizzaComponent* component, MemoryResource& resource);
 };
 
 #endif
\ No newline at end of file
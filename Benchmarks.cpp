@@ -0,0 +1,385 @@
+#include "BasePizza.h"
+#include "ToppingGroup.h"
+#include "Topping.h"
+#include "MemoryResource.h"
+#include "StaticDecorator.h"
+#include "PizzaName.h"
+#include "PriceBatch.h"
+#include "OrderPool.h"
+#include "OrderLifecycle.h"
+#include "ConcreteStates.h"
+#include "OutputSink.h"
+#include "OrderRegistry.h"
+#include "ExtraCheese.h"
+#include "StuffedCrust.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Micro-benchmarks for the hot paths of the pizza model. Build and run with
+// `make bench` (always optimised). Timings are per operation and only
+// meaningful relative to each other on one machine.
+
+namespace {
+    typedef chrono::steady_clock Clock;
+
+    // Results are accumulated here so the optimiser can't drop the work
+    volatile size_t sink = 0;
+
+    // Run body iterations times (after a short warm-up) and print the time per call
+    template <typename Body>
+    void report(const string& label, int iterations, Body body) {
+        for (int i = 0; i < iterations / 10; ++i) {
+            body();
+        }
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            body();
+        }
+        double nanoseconds = chrono::duration<double, nano>(Clock::now() - start).count() / iterations;
+        cout << "  " << left << setw(44) << label << right << setw(10)
+             << fixed << setprecision(1) << nanoseconds << " ns/op" << endl;
+    }
+
+    // Deep copy the way BasePizza and ToppingGroup used to do it: a chain of
+    // dynamic_casts per node, copying every group
+    PizzaComponent* dynamicCastCopy(const PizzaComponent* component, MemoryResource& resource) {
+        if (component->isShared()) {
+            return const_cast<PizzaComponent*>(component);
+        }
+        const Topping* topping = dynamic_cast<const Topping*>(component);
+        if (topping) {
+            return new (resource) Topping(*topping);
+        }
+        const ToppingGroup* group = dynamic_cast<const ToppingGroup*>(component);
+        if (group) {
+            ToppingGroup* copy = new (resource) ToppingGroup(group->getGroupName(), resource);
+            for (const PizzaComponent* child : group->getComponents()) {
+                copy->addComponent(dynamicCastCopy(child, resource));
+            }
+            return copy;
+        }
+        return nullptr;
+    }
+
+    // Recipe nested depth groups deep, one topping per level
+    ToppingGroup* createNestedRecipe(int depth, MemoryResource& resource) {
+        ToppingGroup* root = new (resource) ToppingGroup("Level 0", resource);
+        ToppingGroup* current = root;
+        for (int i = 1; i < depth; ++i) {
+            ToppingGroup* child = new (resource) ToppingGroup("Level " + to_string(i), resource);
+            current->addTopping(static_cast<ToppingId>(i % 11));
+            current->addComponent(child);
+            current = child;
+        }
+        return root;
+    }
+
+    void benchmarkRecipeClone(const string& recipe, ToppingGroup* (*create)(MemoryResource&)) {
+        const int iterations = 200000;
+        cout << recipe << ":" << endl;
+
+        // Source pizzas: one on the heap, one in an arena of its own so that
+        // cloning it into the scratch arena copies every node
+        MonotonicArena sourceArena;
+        BasePizza* heapPizza = new BasePizza(create(MemoryResource::heap()));
+        BasePizza* arenaPizza = new (sourceArena) BasePizza(create(sourceArena));
+
+        MonotonicArena scratch;
+        int sinceRelease = 0;
+        auto recycle = [&]() {
+            if (++sinceRelease == 4096) {
+                scratch.release();
+                sinceRelease = 0;
+            }
+        };
+
+        report("deep copy, dynamic_cast dispatch", iterations, [&]() {
+            Pizza* copy = new (scratch) BasePizza(dynamicCastCopy(arenaPizza->getToppings(), scratch));
+            sink += static_cast<size_t>(copy->getPrice().getCents());
+            delete copy;
+            recycle();
+        });
+
+        report("deep copy, virtual cloneInto", iterations, [&]() {
+            Pizza* copy = arenaPizza->cloneInto(scratch);
+            sink += static_cast<size_t>(copy->getPrice().getCents());
+            delete copy;
+            recycle();
+        });
+
+        report("copy-on-write clone (heap)", iterations, [&]() {
+            Pizza* copy = heapPizza->clone();
+            sink += static_cast<size_t>(copy->getPrice().getCents());
+            delete copy;
+        });
+
+        delete heapPizza;
+        delete arenaPizza;
+    }
+
+    ToppingGroup* createNested64(MemoryResource& resource) {
+        return createNestedRecipe(64, resource);
+    }
+
+    void benchmarkClone() {
+        cout << "=== Clone throughput ===" << endl;
+        benchmarkRecipeClone("Meat Lovers", ToppingGroup::createMeatLoversPizza);
+        benchmarkRecipeClone("Vegetarian Deluxe", ToppingGroup::createVegetarianDeluxePizza);
+        benchmarkRecipeClone("Nested recipe (64 levels)", createNested64);
+        cout << endl;
+    }
+
+    // One heap object per add-on, the way ExtraCheese and StuffedCrust used
+    // to wrap each other: every layer is a virtual call
+    class ChainedAddOn : public Pizza {
+    private:
+        Pizza* pizza;
+        PizzaModifier addOn;
+        Money addOnPrice;
+        const char* addOnName;
+        size_t addOnNameLength;
+
+    public:
+        ChainedAddOn(Pizza* pizzaToDecorate, PizzaModifier modifier)
+            : pizza(pizzaToDecorate), addOn(modifier),
+              addOnPrice(Money::fromCents(ToppingCatalog::DEFAULT_MODIFIERS[modifier].cents)),
+              addOnName(ToppingCatalog::DEFAULT_MODIFIERS[modifier].name),
+              addOnNameLength(char_traits<char>::length(addOnName)) {
+        }
+        ~ChainedAddOn() { delete pizza; }
+
+        Money getPrice() override { return pizza->getPrice() + addOnPrice; }
+        string getName() override { return renderName(*this); }
+        void writeName(NameWriter& out) override {
+            pizza->writeName(out);
+            out.append(" + ");
+            out.append(addOnName, addOnNameLength);
+        }
+        Pizza* cloneInto(MemoryResource& resource) const override {
+            return new (resource) ChainedAddOn(pizza->cloneInto(resource), addOn);
+        }
+    };
+
+    void benchmarkPizza(const string& label, Pizza* pizza) {
+        const int iterations = 2000000;
+        report(label + ", price", iterations, [&]() {
+            sink += static_cast<size_t>(pizza->getPrice().getCents());
+        });
+        report(label + ", name length", iterations, [&]() {
+            sink += nameLength(*pizza);
+        });
+        delete pizza;
+    }
+
+    void benchmarkDecorators() {
+        cout << "=== Decorated pricing (Meat Lovers + Extra Cheese + Stuffed Crust) ===" << endl;
+        // Pin one snapshot so every variant pays the same catalog lookup cost
+        CatalogScope scope;
+
+        benchmarkPizza("virtual chain", new ChainedAddOn(new ChainedAddOn(
+            new BasePizza(ToppingGroup::createMeatLoversPizza()), EXTRA_CHEESE), STUFFED_CRUST));
+        benchmarkPizza("runtime modifier set", new StuffedCrust(new ExtraCheese(
+            new BasePizza(ToppingGroup::createMeatLoversPizza()))));
+        benchmarkPizza("StaticDecorator<BasePizza>", new StaticDecorator<BasePizza, EXTRA_CHEESE, STUFFED_CRUST>(
+            new BasePizza(ToppingGroup::createMeatLoversPizza())));
+        benchmarkPizza("StaticDecorator<StaticPizza>",
+                       new StaticDecorator<StaticPizza<StaticMeatLovers>, EXTRA_CHEESE, STUFFED_CRUST>(
+                           new StaticPizza<StaticMeatLovers>()));
+        cout << endl;
+    }
+
+    void benchmarkBatchPricing() {
+        const size_t pizzaCount = 1024;
+        const int iterations = 2000;
+        cout << "=== Batch pricing (" << pizzaCount << " pizzas, kernel: " << PriceBatch::bestKernelName() << ") ===" << endl;
+        CatalogScope scope;
+
+        vector<Pizza*> pizzas;
+        for (size_t i = 0; i < pizzaCount; ++i) {
+            ToppingGroup* toppings = (i % 2 == 0) ? ToppingGroup::createMeatLoversPizza()
+                                                  : ToppingGroup::createVegetarianDeluxePizza();
+            Pizza* pizza = new BasePizza(toppings);
+            pizzas.push_back(i % 3 == 0 ? new StuffedCrust(new ExtraCheese(pizza)) : pizza);
+        }
+
+        PriceBatch batch(pizzas.data(), pizzas.size());
+        vector<Money> prices(pizzas.size());
+        batch.priceInto(prices.data());
+        for (size_t i = 0; i < pizzas.size(); ++i) {
+            if (prices[i] != pizzas[i]->getPrice()) {
+                cout << "  Batch price mismatch at pizza " << i << endl;
+                break;
+            }
+        }
+
+        report("getPrice() per pizza", iterations, [&]() {
+            for (Pizza* pizza : pizzas) {
+                sink += static_cast<size_t>(pizza->getPrice().getCents());
+            }
+        });
+        report("batch, scalar kernel", iterations, [&]() {
+            batch.priceInto(prices.data(), PriceBatch::SCALAR);
+            sink += static_cast<size_t>(prices.back().getCents());
+        });
+        report("batch, avx2 kernel", iterations, [&]() {
+            batch.priceInto(prices.data(), PriceBatch::AVX2);
+            sink += static_cast<size_t>(prices.back().getCents());
+        });
+        report("batch, best kernel", iterations, [&]() {
+            batch.priceInto(prices.data());
+            sink += static_cast<size_t>(prices.back().getCents());
+        });
+        report("batch, flatten and price", iterations, [&]() {
+            PriceBatch::priceAll(pizzas.data(), pizzas.size(), prices.data());
+            sink += static_cast<size_t>(prices.back().getCents());
+        });
+
+        for (Pizza* pizza : pizzas) {
+            delete pizza;
+        }
+        cout << endl;
+    }
+
+    // One customer: an order with a few pizzas, priced, then thrown away
+    void fillOrder(PizzaOrders& order) {
+        order.addPizza(order.createMeatLoversPizza(true, false));
+        order.addPizza(order.createPepperoniPizza());
+        order.addPizza(order.createVegetarianPizza(false, true));
+        sink += static_cast<size_t>(order.getDiscountedTotal().getCents());
+    }
+
+    void benchmarkOrderPool() {
+        const int iterations = 100000;
+        cout << "=== Order lifecycle (3 pizzas) ===" << endl;
+        CatalogScope scope;
+
+        report("new and delete", iterations, [&]() {
+            PizzaOrders* order = new PizzaOrders(1, "Bench");
+            fillOrder(*order);
+            delete order;
+        });
+        OrderPool::local().clear();
+        report("OrderPool::local()", iterations, [&]() {
+            PooledOrder order = OrderPool::local().acquire(1, "Bench");
+            fillOrder(*order);
+        });
+        cout << "  hit rate " << fixed << setprecision(3) << OrderPool::local().getStats().hitRate() << endl;
+        cout << endl;
+    }
+    // Walk 1000 orders from Ordering to Completed, one event at a time per
+    // order and one event for all of them at once
+    void benchmarkStateMachine() {
+        const int iterations = 2000;
+        const OrderEvent steps[] = {CONFIRM_ORDER, PAY_ORDER, PREPARE_ORDER, DELIVER_ORDER, COMPLETE_ORDER};
+        cout << "=== State machine (1000 orders to Completed) ===" << endl;
+        CatalogScope scope;
+
+        vector<PizzaOrders*> orders;
+        for (int i = 0; i < 1000; ++i) {
+            PizzaOrders* order = new PizzaOrders(i, "Bench");
+            order->addPizza(order->createPepperoniPizza());
+            orders.push_back(order);
+        }
+        StringSink messages;
+
+        report("dispatch per order", iterations, [&]() {
+            for (PizzaOrders* order : orders) {
+                order->setState(OrderingState::instance());
+                for (OrderEvent event : steps) {
+                    sink += OrderLifecycle::dispatch(*order, event, 0, messages) ? 1 : 0;
+                }
+            }
+            messages.clear();
+        });
+        report("dispatch into one document", iterations, [&]() {
+            Document document(messages);
+            for (PizzaOrders* order : orders) {
+                order->setState(OrderingState::instance());
+                for (OrderEvent event : steps) {
+                    sink += OrderLifecycle::dispatch(*order, event, 0, document) ? 1 : 0;
+                }
+            }
+            messages.clear();
+        });
+        report("apply to all", iterations, [&]() {
+            for (PizzaOrders* order : orders) {
+                order->setState(OrderingState::instance());
+            }
+            for (OrderEvent event : steps) {
+                sink += OrderLifecycle::apply(event, orders.data(), orders.size(), messages);
+            }
+            messages.clear();
+        });
+
+        for (PizzaOrders* order : orders) {
+            delete order;
+        }
+        cout << endl;
+    }
+
+    // Every thread runs rounds of create, find, transition and retire on its
+    // own orders; prints the rounds per second of all threads together for
+    // one shard and for the default shard count, at 1 to 8 threads. The
+    // hardware thread count is printed alongside, since it bounds what the
+    // figures can show.
+    void benchmarkOrderRegistry() {
+        const int rounds = 20000;
+        cout << "=== Order registry (create, find, transition, retire) ===" << endl;
+        unsigned cores = thread::hardware_concurrency();
+        cout << "  " << cores << " hardware threads" << endl;
+
+        const size_t shardCounts[] = {1, OrderRegistry::DEFAULT_SHARD_COUNT};
+        for (size_t shardCount : shardCounts) {
+            for (unsigned threads = 1; threads <= 8; threads *= 2) {
+                OrderRegistry registry(shardCount);
+                vector<thread> workers;
+                vector<size_t> found(threads, 0);   // Per thread, added to sink after the join
+                Clock::time_point start = Clock::now();
+                for (unsigned t = 0; t < threads; ++t) {
+                    workers.push_back(thread([&registry, &found, t, rounds]() {
+                        StringSink messages;
+                        size_t hits = 0;
+                        for (int i = 0; i < rounds; ++i) {
+                            int number = registry.create("Bench").getOrderNumber();
+                            hits += registry.find(number) ? 1 : 0;
+                            registry.transition(number, CANCEL_ORDER, 0, messages);
+                            registry.retire(number);
+                            if (i % 256 == 0) {
+                                messages.clear();
+                            }
+                        }
+                        found[t] = hits;
+                    }));
+                }
+                for (thread& worker : workers) {
+                    worker.join();
+                }
+                double seconds = chrono::duration<double>(Clock::now() - start).count();
+                for (size_t hits : found) {
+                    sink += hits;
+                }
+                double total = static_cast<double>(rounds) * threads;
+                cout << "  " << left << setw(12) << (to_string(shardCount) + " shard" + (shardCount == 1 ? "" : "s"))
+                     << setw(32) << (to_string(threads) + " thread" + (threads == 1 ? "" : "s")) << right << setw(10)
+                     << fixed << setprecision(2) << total / seconds / 1e6 << " M rounds/s" << endl;
+            }
+        }
+        cout << endl;
+    }
+}
+
+int main() {
+    benchmarkClone();
+    benchmarkDecorators();
+    benchmarkBatchPricing();
+    benchmarkOrderPool();
+    benchmarkStateMachine();
+    benchmarkOrderRegistry();
+    return sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,468 @@
+#include "CatalogImage.h"
+#include "ToppingCatalog.h"
+#include "ToppingGroup.h"
+#include "Topping.h"
+#include "BasePizza.h"
+#include "StaticDecorator.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace CatalogImageFormat {
+    const char MAGIC[8] = {'P', 'I', 'Z', 'Z', 'A', 'I', 'M', 'G'};
+    const uint32_t ENDIAN_MARKER = 0x01020304;
+
+    struct Header {
+        char magic[8];
+        uint32_t endianMarker;
+        uint32_t formatVersion;
+        uint64_t fileSize;
+        uint64_t catalogVersion;
+        uint32_t toppingCount;
+        uint32_t indexedCount;   // Available toppings, i.e. entries in the name index
+        uint32_t recipeCount;
+        uint32_t nodeCount;
+        uint32_t menuCount;
+        uint32_t reserved;
+        uint64_t pricesOffset;
+        uint64_t toppingsOffset;
+        uint64_t nameIndexOffset;
+        uint64_t recipesOffset;
+        uint64_t nodesOffset;
+        uint64_t menuOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+    };
+
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct ToppingRecord {
+        StringRef name;
+        uint32_t available;
+        uint32_t reserved;
+    };
+
+    struct RecipeRecord {
+        StringRef name;
+        uint32_t firstNode;
+        uint32_t nodeCount;
+    };
+
+    // Pre-order node: a group (toppingId < 0) or a topping leaf
+    struct RecipeNode {
+        int32_t toppingId;
+        uint32_t depth;
+        uint32_t quantity;      // Portions of a topping (1 for groups)
+        StringRef groupName;
+    };
+
+    struct MenuRecord {
+        uint32_t recipeIndex;
+        uint8_t extraCheese;
+        uint8_t stuffedCrust;
+        uint8_t special;
+        uint8_t reserved;
+        StringRef description;
+    };
+}
+
+using namespace CatalogImageFormat;
+
+namespace {
+    // Sections start on 8-byte boundaries so records can be read in place
+    size_t alignUp(size_t value) {
+        return (value + 7) & ~static_cast<size_t>(7);
+    }
+
+    bool fits(uint64_t offset, uint64_t count, uint64_t recordSize, uint64_t fileSize) {
+        return offset % 8 == 0 && offset <= fileSize && count <= (fileSize - offset) / recordSize;
+    }
+
+    // Collects the string pool while an image is being written
+    class StringPool {
+    private:
+        std::string data;
+
+    public:
+        StringRef add(const std::string& text) {
+            StringRef ref;
+            ref.offset = static_cast<uint32_t>(data.size());
+            ref.length = static_cast<uint32_t>(text.size());
+            data += text;
+            return ref;
+        }
+
+        const std::string& getData() const { return data; }
+    };
+
+    // Append a group and its subtree to the node list in pre-order
+    void flattenGroup(const ToppingGroup* group, uint32_t depth,
+                      std::vector<RecipeNode>& nodes, StringPool& pool) {
+        RecipeNode node;
+        node.toppingId = -1;
+        node.depth = depth;
+        node.quantity = 1;
+        node.groupName = pool.add(group->getGroupName());
+        nodes.push_back(node);
+
+        for (const PizzaComponent* component : group->getComponents()) {
+            if (component->getKind() == PizzaComponent::TOPPING) {
+                const Topping* topping = static_cast<const Topping*>(component);
+                RecipeNode leaf;
+                leaf.toppingId = topping->getId();
+                leaf.depth = depth + 1;
+                leaf.quantity = topping->getQuantity();
+                leaf.groupName.offset = 0;
+                leaf.groupName.length = 0;
+                nodes.push_back(leaf);
+            } else if (component->getKind() == PizzaComponent::GROUP) {
+                flattenGroup(static_cast<const ToppingGroup*>(component), depth + 1, nodes, pool);
+            }
+        }
+    }
+
+    template <typename T>
+    void appendSection(std::string& out, const std::vector<T>& records, uint64_t& offset) {
+        out.resize(alignUp(out.size()), '\0');
+        offset = out.size();
+        if (!records.empty()) {
+            out.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+        }
+    }
+}
+
+// ==================== Loading ====================
+
+CatalogImage::CatalogImage(const char* mappedBase, size_t mappedSize)
+    : base(mappedBase), size(mappedSize) {
+    header = reinterpret_cast<const Header*>(base);
+    prices = reinterpret_cast<const int64_t*>(base + header->pricesOffset);
+    toppings = reinterpret_cast<const ToppingRecord*>(base + header->toppingsOffset);
+    nameIndex = reinterpret_cast<const uint32_t*>(base + header->nameIndexOffset);
+    recipes = reinterpret_cast<const RecipeRecord*>(base + header->recipesOffset);
+    nodes = reinterpret_cast<const RecipeNode*>(base + header->nodesOffset);
+    menu = reinterpret_cast<const MenuRecord*>(base + header->menuOffset);
+    strings = base + header->stringsOffset;
+}
+
+CatalogImage::~CatalogImage() {
+    munmap(const_cast<char*>(base), size);
+}
+
+std::shared_ptr<const CatalogImage> CatalogImage::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error: Could not open catalog image '" << path << "'." << std::endl;
+        return std::shared_ptr<const CatalogImage>();
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        std::cerr << "Error: Catalog image '" << path << "' is too small." << std::endl;
+        close(fd);
+        return std::shared_ptr<const CatalogImage>();
+    }
+
+    size_t fileSize = static_cast<size_t>(info.st_size);
+    void* mapped = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (mapped == MAP_FAILED) {
+        std::cerr << "Error: Could not map catalog image '" << path << "'." << std::endl;
+        return std::shared_ptr<const CatalogImage>();
+    }
+
+    // Only the header and section bounds are checked here, so opening an
+    // image doesn't touch pages in proportion to its size
+    const Header* header = static_cast<const Header*>(mapped);
+    bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 header->endianMarker == ENDIAN_MARKER &&
+                 header->formatVersion == FORMAT_VERSION &&
+                 header->fileSize == fileSize &&
+                 fits(header->pricesOffset, header->toppingCount, sizeof(int64_t), fileSize) &&
+                 fits(header->toppingsOffset, header->toppingCount, sizeof(ToppingRecord), fileSize) &&
+                 header->indexedCount <= header->toppingCount &&
+                 fits(header->nameIndexOffset, header->indexedCount, sizeof(uint32_t), fileSize) &&
+                 fits(header->recipesOffset, header->recipeCount, sizeof(RecipeRecord), fileSize) &&
+                 fits(header->nodesOffset, header->nodeCount, sizeof(RecipeNode), fileSize) &&
+                 fits(header->menuOffset, header->menuCount, sizeof(MenuRecord), fileSize) &&
+                 fits(header->stringsOffset, header->stringsSize, 1, fileSize);
+    if (!valid) {
+        std::cerr << "Error: Catalog image '" << path << "' is invalid or has an unsupported format." << std::endl;
+        munmap(mapped, fileSize);
+        return std::shared_ptr<const CatalogImage>();
+    }
+
+    return std::shared_ptr<const CatalogImage>(new CatalogImage(static_cast<const char*>(mapped), fileSize));
+}
+
+ImageString CatalogImage::resolve(const StringRef& ref) const {
+    ImageString result;
+    if (static_cast<uint64_t>(ref.offset) + ref.length <= header->stringsSize) {
+        result.data = strings + ref.offset;
+        result.length = ref.length;
+    } else {
+        result.data = strings;
+        result.length = 0;
+    }
+    return result;
+}
+
+// ==================== Writing ====================
+
+bool CatalogImage::write(const std::string& path, const ToppingCatalog& catalog,
+                         const std::vector<const ToppingGroup*>& recipeGroups,
+                         const std::vector<ImageMenuEntry>& menuEntries) {
+    StringPool pool;
+
+    // Toppings, with a name index sorted the same way findTopping compares
+    uint32_t toppingCount = static_cast<uint32_t>(catalog.size());
+    std::vector<int64_t> priceTable(toppingCount);
+    std::vector<ToppingRecord> toppingRecords(toppingCount);
+    std::vector<std::string> nameTable(toppingCount);
+    std::vector<uint32_t> sortedIds;
+    for (uint32_t id = 0; id < toppingCount; ++id) {
+        priceTable[id] = catalog.getPrice(static_cast<ToppingId>(id)).getCents();
+        nameTable[id] = catalog.getName(static_cast<ToppingId>(id));
+        toppingRecords[id].name = pool.add(nameTable[id]);
+        toppingRecords[id].available = catalog.isAvailable(static_cast<ToppingId>(id)) ? 1 : 0;
+        toppingRecords[id].reserved = 0;
+        if (toppingRecords[id].available) {
+            sortedIds.push_back(id);
+        }
+    }
+    std::sort(sortedIds.begin(), sortedIds.end(), [&nameTable](uint32_t a, uint32_t b) {
+        return nameTable[a] < nameTable[b];
+    });
+
+    // Recipe trees in pre-order
+    std::vector<RecipeRecord> recipeRecords;
+    std::vector<RecipeNode> recipeNodes;
+    std::vector<const ToppingGroup*> writtenGroups;   // Parallel to recipeRecords
+    for (const ToppingGroup* group : recipeGroups) {
+        if (group == nullptr) {
+            continue;
+        }
+        writtenGroups.push_back(group);
+        RecipeRecord record;
+        record.name = pool.add(group->getGroupName());
+        record.firstNode = static_cast<uint32_t>(recipeNodes.size());
+        flattenGroup(group, 0, recipeNodes, pool);
+        record.nodeCount = static_cast<uint32_t>(recipeNodes.size()) - record.firstNode;
+        recipeRecords.push_back(record);
+    }
+
+    // Menu entries refer to recipes by their index among the written records
+    std::vector<MenuRecord> menuRecords;
+    for (const ImageMenuEntry& entry : menuEntries) {
+        uint32_t recipeIndex = static_cast<uint32_t>(recipeRecords.size());
+        for (size_t i = 0; i < writtenGroups.size(); ++i) {
+            if (writtenGroups[i]->getGroupName() == entry.recipeName) {
+                recipeIndex = static_cast<uint32_t>(i);
+                break;
+            }
+        }
+        if (recipeIndex >= recipeRecords.size()) {
+            std::cerr << "Error: Menu entry refers to unknown recipe '" << entry.recipeName << "'." << std::endl;
+            return false;
+        }
+        MenuRecord record;
+        record.recipeIndex = recipeIndex;
+        record.extraCheese = entry.extraCheese ? 1 : 0;
+        record.stuffedCrust = entry.stuffedCrust ? 1 : 0;
+        record.special = entry.special ? 1 : 0;
+        record.reserved = 0;
+        record.description = pool.add(entry.description);
+        menuRecords.push_back(record);
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.endianMarker = ENDIAN_MARKER;
+    header.formatVersion = FORMAT_VERSION;
+    header.catalogVersion = catalog.getVersion();
+    header.toppingCount = toppingCount;
+    header.indexedCount = static_cast<uint32_t>(sortedIds.size());
+    header.recipeCount = static_cast<uint32_t>(recipeRecords.size());
+    header.nodeCount = static_cast<uint32_t>(recipeNodes.size());
+    header.menuCount = static_cast<uint32_t>(menuRecords.size());
+
+    std::string out(sizeof(Header), '\0');
+    appendSection(out, priceTable, header.pricesOffset);
+    appendSection(out, toppingRecords, header.toppingsOffset);
+    appendSection(out, sortedIds, header.nameIndexOffset);
+    appendSection(out, recipeRecords, header.recipesOffset);
+    appendSection(out, recipeNodes, header.nodesOffset);
+    appendSection(out, menuRecords, header.menuOffset);
+    out.resize(alignUp(out.size()), '\0');
+    header.stringsOffset = out.size();
+    header.stringsSize = pool.getData().size();
+    out += pool.getData();
+    header.fileSize = out.size();
+    std::memcpy(&out[0], &header, sizeof(header));
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+            std::cerr << "Error: Could not write catalog image '" << tempPath << "'." << std::endl;
+            return false;
+        }
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error: Could not replace catalog image '" << path << "'." << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ==================== Accessors ====================
+
+uint64_t CatalogImage::getCatalogVersion() const {
+    return header->catalogVersion;
+}
+
+uint32_t CatalogImage::getToppingCount() const {
+    return header->toppingCount;
+}
+
+ImageString CatalogImage::getToppingName(uint32_t id) const {
+    if (id >= header->toppingCount) {
+        return resolve(StringRef());
+    }
+    return resolve(toppings[id].name);
+}
+
+bool CatalogImage::isToppingAvailable(uint32_t id) const {
+    return id < header->toppingCount && toppings[id].available != 0;
+}
+
+const int64_t* CatalogImage::getPriceTable() const {
+    return prices;
+}
+
+int CatalogImage::findTopping(const std::string& toppingName) const {
+    // Binary search over IDs sorted by name, comparing bytes in the mapping
+    uint32_t low = 0;
+    uint32_t high = header->indexedCount;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        uint32_t id = nameIndex[middle];
+        ImageString candidate = getToppingName(id);
+        size_t common = std::min<size_t>(candidate.length, toppingName.size());
+        int order = std::memcmp(candidate.data, toppingName.data(), common);
+        if (order == 0) {
+            if (candidate.length == toppingName.size()) {
+                return static_cast<int>(id);
+            }
+            order = candidate.length < toppingName.size() ? -1 : 1;
+        }
+        if (order < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return ToppingCatalog::INVALID_ID;
+}
+
+uint32_t CatalogImage::getRecipeCount() const {
+    return header->recipeCount;
+}
+
+ImageString CatalogImage::getRecipeName(uint32_t index) const {
+    if (index >= header->recipeCount) {
+        return resolve(StringRef());
+    }
+    return resolve(recipes[index].name);
+}
+
+int CatalogImage::findRecipe(const std::string& recipeName) const {
+    for (uint32_t i = 0; i < header->recipeCount; ++i) {
+        ImageString name = getRecipeName(i);
+        if (name.length == recipeName.size() && std::memcmp(name.data, recipeName.data(), name.length) == 0) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+ToppingGroup* CatalogImage::buildRecipe(uint32_t index) const {
+    if (index >= header->recipeCount) {
+        return nullptr;
+    }
+    const RecipeRecord& record = recipes[index];
+    if (record.nodeCount == 0 || record.firstNode > header->nodeCount ||
+        record.nodeCount > header->nodeCount - record.firstNode ||
+        nodes[record.firstNode].toppingId >= 0) {
+        return nullptr;
+    }
+
+    // Rebuild the tree from pre-order nodes: the open groups form a stack by depth
+    ToppingGroup* root = new ToppingGroup(resolve(nodes[record.firstNode].groupName).str());
+    std::vector<ToppingGroup*> open(1, root);
+    for (uint32_t i = 1; i < record.nodeCount; ++i) {
+        const RecipeNode& node = nodes[record.firstNode + i];
+        if (node.depth == 0 || node.depth > open.size()) {
+            break;  // Malformed image, keep what was built so far
+        }
+        open.resize(node.depth);
+        ToppingGroup* parent = open.back();
+        if (node.toppingId >= 0) {
+            parent->addTopping(node.toppingId, node.quantity);
+        } else {
+            ToppingGroup* group = new ToppingGroup(resolve(node.groupName).str());
+            parent->addComponent(group);
+            open.push_back(group);
+        }
+    }
+    return root;
+}
+
+uint32_t CatalogImage::getMenuEntryCount() const {
+    return header->menuCount;
+}
+
+bool CatalogImage::isSpecial(uint32_t index) const {
+    return index < header->menuCount && menu[index].special != 0;
+}
+
+ImageString CatalogImage::getMenuDescription(uint32_t index) const {
+    if (index >= header->menuCount) {
+        return resolve(StringRef());
+    }
+    return resolve(menu[index].description);
+}
+
+Pizza* CatalogImage::buildMenuPizza(uint32_t index) const {
+    if (index >= header->menuCount) {
+        return nullptr;
+    }
+    const MenuRecord& record = menu[index];
+    ToppingGroup* toppings = buildRecipe(record.recipeIndex);
+    if (toppings == nullptr) {
+        return nullptr;
+    }
+
+    BasePizza* pizza = new BasePizza(toppings);
+    if (record.extraCheese && record.stuffedCrust) {
+        return new StaticDecorator<BasePizza, EXTRA_CHEESE, STUFFED_CRUST>(pizza);
+    }
+    if (record.extraCheese) {
+        return new StaticDecorator<BasePizza, EXTRA_CHEESE>(pizza);
+    }
+    if (record.stuffedCrust) {
+        return new StaticDecorator<BasePizza, STUFFED_CRUST>(pizza);
+    }
+    return pizza;
+}
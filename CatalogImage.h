@@ -0,0 +1,112 @@
+#ifndef CATALOGIMAGE_H
+#define CATALOGIMAGE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+class ToppingCatalog;
+class ToppingGroup;
+class Pizza;
+
+// On-disk record layouts (defined in CatalogImage.cpp)
+namespace CatalogImageFormat {
+    struct Header;
+    struct StringRef;
+    struct ToppingRecord;
+    struct RecipeRecord;
+    struct RecipeNode;
+    struct MenuRecord;
+}
+
+// Read-only view of a string stored inside the image
+struct ImageString {
+    const char* data;
+    uint32_t length;
+
+    std::string str() const { return std::string(data, length); }
+};
+
+// Description of one menu entry, used when writing an image
+struct ImageMenuEntry {
+    std::string recipeName;   // Must match the group name of one of the written recipes
+    bool extraCheese;
+    bool stuffedCrust;
+    bool special;             // Goes on the specials menu instead of the main menu
+    std::string description;  // Special offer text (specials only)
+};
+
+// Versioned binary image holding the topping catalog, recipe trees and menu
+// entries. open() maps the file read-only and every accessor reads straight
+// from the mapped pages, so opening costs the same whatever the catalog size
+// and worker processes that map the same file share its physical pages.
+//
+// Layout: header, flat price table in cents (indexed by ToppingId), topping records,
+// available topping IDs sorted by name (binary searched by findTopping),
+// recipe records, recipe nodes in pre-order with their depth, menu records
+// and a string pool. All integers are in host byte order; the header records an
+// endian marker so an image from a different architecture is rejected.
+// A mapped image must never be modified in place; write() always replaces
+// the file by renaming a new one over it.
+class CatalogImage {
+private:
+    const char* base;
+    size_t size;
+
+    const CatalogImageFormat::Header* header;
+    const int64_t* prices;
+    const CatalogImageFormat::ToppingRecord* toppings;
+    const uint32_t* nameIndex;
+    const CatalogImageFormat::RecipeRecord* recipes;
+    const CatalogImageFormat::RecipeNode* nodes;
+    const CatalogImageFormat::MenuRecord* menu;
+    const char* strings;
+
+    CatalogImage(const char* mappedBase, size_t mappedSize);
+    CatalogImage(const CatalogImage&) = delete;
+    CatalogImage& operator=(const CatalogImage&) = delete;
+
+    // Resolve a string reference, returns an empty string if it is out of bounds
+    ImageString resolve(const CatalogImageFormat::StringRef& ref) const;
+
+public:
+    static const uint32_t FORMAT_VERSION = 3;
+
+    // Map an image file. Returns nullptr if the file is missing or invalid.
+    static std::shared_ptr<const CatalogImage> open(const std::string& path);
+
+    // Write the catalog, recipes and menu entries to an image file. The file
+    // is written to a temporary name and renamed, so processes that still
+    // map the previous image keep a consistent copy.
+    static bool write(const std::string& path, const ToppingCatalog& catalog,
+                      const std::vector<const ToppingGroup*>& recipeGroups,
+                      const std::vector<ImageMenuEntry>& menuEntries);
+
+    ~CatalogImage();
+
+    // Catalog version the image was written from
+    uint64_t getCatalogVersion() const;
+
+    // Toppings (IDs are the catalog IDs at the time of writing)
+    uint32_t getToppingCount() const;
+    ImageString getToppingName(uint32_t id) const;
+    bool isToppingAvailable(uint32_t id) const;
+    const int64_t* getPriceTable() const;
+    int findTopping(const std::string& toppingName) const;
+
+    // Recipes
+    uint32_t getRecipeCount() const;
+    ImageString getRecipeName(uint32_t index) const;
+    int findRecipe(const std::string& recipeName) const;
+    ToppingGroup* buildRecipe(uint32_t index) const;
+
+    // Menu entries
+    uint32_t getMenuEntryCount() const;
+    bool isSpecial(uint32_t index) const;
+    ImageString getMenuDescription(uint32_t index) const;
+    Pizza* buildMenuPizza(uint32_t index) const;
+};
+
+#endif
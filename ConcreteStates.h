@@ -2,140 +2,74 @@
 #define CONCRETESTATES_H
 
 #include "OrderState.h"
-#include "PizzaOrders.h"
-#include <iostream>
+
+// One class per lifecycle status. The states hold nothing but their status,
+// so each has one immutable process-wide instance (instance()) that every
+// order shares: a transition swaps a pointer and never allocates. Orders
+// still adopt states created with new through PizzaOrders::setState(OrderState*).
+// What the events do is in OrderLifecycle's table.
 
 // ==================== ORDERING STATE ====================
 class OrderingState : public OrderState {
 public:
-    void addPizza(PizzaOrders* context) override;
-    void removePizza(PizzaOrders* context, int index) override;
-    void confirmOrder(PizzaOrders* context) override;
-    void cancelOrder(PizzaOrders* context) override;
-    void payOrder(PizzaOrders* context) override;
-    void prepareOrder(PizzaOrders* context) override;
-    void deliverOrder(PizzaOrders* context) override;
-    void completeOrder(PizzaOrders* context) override;
+    OrderingState() : OrderState(ORDERING) {}
     
-    std::string getStateName() const override { return "Ordering"; }
-    bool canModifyOrder() const override { return true; }
-    std::string getAvailableActions() const override { 
-        return "Add Pizza, Remove Pizza, Confirm Order, Cancel Order"; 
-    }
+    // Process-wide instance used by the transitions
+    static OrderingState& instance();
 };
 
 // ==================== CONFIRMED STATE ====================
 class ConfirmedState : public OrderState {
 public:
-    void addPizza(PizzaOrders* context) override;
-    void removePizza(PizzaOrders* context, int index) override;
-    void confirmOrder(PizzaOrders* context) override;
-    void cancelOrder(PizzaOrders* context) override;
-    void payOrder(PizzaOrders* context) override;
-    void prepareOrder(PizzaOrders* context) override;
-    void deliverOrder(PizzaOrders* context) override;
-    void completeOrder(PizzaOrders* context) override;
+    ConfirmedState() : OrderState(CONFIRMED) {}
     
-    std::string getStateName() const override { return "Confirmed"; }
-    bool canModifyOrder() const override { return false; }
-    std::string getAvailableActions() const override { 
-        return "Pay Order, Cancel Order"; 
-    }
+    // Process-wide instance used by the transitions
+    static ConfirmedState& instance();
 };
 
 // ==================== PAID STATE ====================
 class PaidState : public OrderState {
 public:
-    void addPizza(PizzaOrders* context) override;
-    void removePizza(PizzaOrders* context, int index) override;
-    void confirmOrder(PizzaOrders* context) override;
-    void cancelOrder(PizzaOrders* context) override;
-    void payOrder(PizzaOrders* context) override;
-    void prepareOrder(PizzaOrders* context) override;
-    void deliverOrder(PizzaOrders* context) override;
-    void completeOrder(PizzaOrders* context) override;
+    PaidState() : OrderState(PAID) {}
     
-    std::string getStateName() const override { return "Paid"; }
-    bool canModifyOrder() const override { return false; }
-    std::string getAvailableActions() const override { 
-        return "Prepare Order, Cancel Order (with refund)"; 
-    }
+    // Process-wide instance used by the transitions
+    static PaidState& instance();
 };
 
 // ==================== PREPARING STATE ====================
 class PreparingState : public OrderState {
 public:
-    void addPizza(PizzaOrders* context) override;
-    void removePizza(PizzaOrders* context, int index) override;
-    void confirmOrder(PizzaOrders* context) override;
-    void cancelOrder(PizzaOrders* context) override;
-    void payOrder(PizzaOrders* context) override;
-    void prepareOrder(PizzaOrders* context) override;
-    void deliverOrder(PizzaOrders* context) override;
-    void completeOrder(PizzaOrders* context) override;
+    PreparingState() : OrderState(PREPARING) {}
     
-    std::string getStateName() const override { return "Preparing"; }
-    bool canModifyOrder() const override { return false; }
-    std::string getAvailableActions() const override { 
-        return "Deliver Order"; 
-    }
+    // Process-wide instance used by the transitions
+    static PreparingState& instance();
 };
 
 // ==================== DELIVERING STATE ====================
 class DeliveringState : public OrderState {
 public:
-    void addPizza(PizzaOrders* context) override;
-    void removePizza(PizzaOrders* context, int index) override;
-    void confirmOrder(PizzaOrders* context) override;
-    void cancelOrder(PizzaOrders* context) override;
-    void payOrder(PizzaOrders* context) override;
-    void prepareOrder(PizzaOrders* context) override;
-    void deliverOrder(PizzaOrders* context) override;
-    void completeOrder(PizzaOrders* context) override;
+    DeliveringState() : OrderState(DELIVERING) {}
     
-    std::string getStateName() const override { return "Delivering"; }
-    bool canModifyOrder() const override { return false; }
-    std::string getAvailableActions() const override { 
-        return "Complete Order"; 
-    }
+    // Process-wide instance used by the transitions
+    static DeliveringState& instance();
 };
 
 // ==================== COMPLETED STATE ====================
 class CompletedState : public OrderState {
 public:
-    void addPizza(PizzaOrders* context) override;
-    void removePizza(PizzaOrders* context, int index) override;
-    void confirmOrder(PizzaOrders* context) override;
-    void cancelOrder(PizzaOrders* context) override;
-    void payOrder(PizzaOrders* context) override;
-    void prepareOrder(PizzaOrders* context) override;
-    void deliverOrder(PizzaOrders* context) override;
-    void completeOrder(PizzaOrders* context) override;
+    CompletedState() : OrderState(COMPLETED) {}
     
-    std::string getStateName() const override { return "Completed"; }
-    bool canModifyOrder() const override { return false; }
-    std::string getAvailableActions() const override { 
-        return "Order is complete - no actions available"; 
-    }
+    // Process-wide instance used by the transitions
+    static CompletedState& instance();
 };
 
 // ==================== CANCELLED STATE ====================
 class CancelledState : public OrderState {
 public:
-    void addPizza(PizzaOrders* context) override;
-    void removePizza(PizzaOrders* context, int index) override;
-    void confirmOrder(PizzaOrders* context) override;
-    void cancelOrder(PizzaOrders* context) override;
-    void payOrder(PizzaOrders* context) override;
-    void prepareOrder(PizzaOrders* context) override;
-    void deliverOrder(PizzaOrders* context) override;
-    void completeOrder(PizzaOrders* context) override;
+    CancelledState() : OrderState(CANCELLED) {}
     
-    std::string getStateName() const override { return "Cancelled"; }
-    bool canModifyOrder() const override { return false; }
-    std::string getAvailableActions() const override { 
-        return "Order is cancelled - no actions available"; 
-    }
+    // Process-wide instance used by the transitions
+    static CancelledState& instance();
 };
 
-#endif // CONCRETESTATES_H
\ No newline at end of file
+#endif // CONCRETESTATES_H
@@ -3,10 +3,10 @@
 #include <algorithm>
 
 // ==================== RegularPrice Strategy ====================
-double RegularPrice::applyDiscount(const PizzaOrders& order) const {
+Money RegularPrice::applyDiscount(const PizzaOrders& order) const {
     (void)order;
     // No discount applied - return 0
-    return 0.0;
+    return Money();
 }
 
 std::string RegularPrice::getStrategyName() const {
@@ -18,18 +18,18 @@ std::string RegularPrice::getDescription() const {
 }
 
 // ==================== FamilyDiscount Strategy ====================
-double FamilyDiscount::applyDiscount(const PizzaOrders& order) const {
-    double totalPrice = order.getTotalPrice();
+Money FamilyDiscount::applyDiscount(const PizzaOrders& order) const {
+    Money totalPrice = order.getTotalPrice();
     int pizzaCount = order.getPizzaCount();
     
     // Family discount: 15% off if ordering 3+ pizzas, 10% off if ordering 2+ pizzas
     if (pizzaCount >= 3) {
-        return totalPrice * 0.15; // 15% discount
+        return totalPrice.percent(15); // 15% discount
     } else if (pizzaCount >= 2) {
-        return totalPrice * 0.10; // 10% discount
+        return totalPrice.percent(10); // 10% discount
     }
     
-    return 0.0; // No discount for single pizza
+    return Money(); // No discount for single pizza
 }
 
 std::string FamilyDiscount::getStrategyName() const {
@@ -41,19 +41,19 @@ std::string FamilyDiscount::getDescription() const {
 }
 
 // ==================== BulkDiscount Strategy ====================
-double BulkDiscount::applyDiscount(const PizzaOrders& order) const {
-    double totalPrice = order.getTotalPrice();
+Money BulkDiscount::applyDiscount(const PizzaOrders& order) const {
+    Money totalPrice = order.getTotalPrice();
     
     // Bulk discount based on total price
-    if (totalPrice >= 500.0) {
-        return totalPrice * 0.20; // 20% discount for orders R500+
-    } else if (totalPrice >= 300.0) {
-        return totalPrice * 0.15; // 15% discount for orders R300+
-    } else if (totalPrice >= 150.0) {
-        return totalPrice * 0.10; // 10% discount for orders R150+
+    if (totalPrice >= Money::fromRands(500)) {
+        return totalPrice.percent(20); // 20% discount for orders R500+
+    } else if (totalPrice >= Money::fromRands(300)) {
+        return totalPrice.percent(15); // 15% discount for orders R300+
+    } else if (totalPrice >= Money::fromRands(150)) {
+        return totalPrice.percent(10); // 10% discount for orders R150+
     }
     
-    return 0.0; // No discount for orders under R150
+    return Money(); // No discount for orders under R150
 }
 
 std::string BulkDiscount::getStrategyName() const {
@@ -65,11 +65,11 @@ std::string BulkDiscount::getDescription() const {
 }
 
 // ==================== StudentDiscount Strategy ====================
-double StudentDiscount::applyDiscount(const PizzaOrders& order) const {
-    double totalPrice = order.getTotalPrice();
+Money StudentDiscount::applyDiscount(const PizzaOrders& order) const {
+    Money totalPrice = order.getTotalPrice();
     
     // Student discount: flat 12% off entire order
-    return totalPrice * 0.12;
+    return totalPrice.percent(12);
 }
 
 std::string StudentDiscount::getStrategyName() const {
@@ -81,18 +81,19 @@ std::string StudentDiscount::getDescription() const {
 }
 
 // ==================== SeniorDiscount Strategy ====================
-double SeniorDiscount::applyDiscount(const PizzaOrders& order) const {
-    double totalPrice = order.getTotalPrice();
+Money SeniorDiscount::applyDiscount(const PizzaOrders& order) const {
+    Money totalPrice = order.getTotalPrice();
     int pizzaCount = order.getPizzaCount();
     
-    // Senior discount: 15% off, plus additional 5% if ordering 2+ pizzas
-    double discount = totalPrice * 0.15; // Base 15% discount
+    // Senior discount: 15% off, plus additional 5% if ordering 2+ pizzas.
+    // The rates are added before rounding so the discount is rounded once.
+    int percentage = 15; // Base 15% discount
     
     if (pizzaCount >= 2) {
-        discount += totalPrice * 0.05; // Additional 5% for multiple pizzas
+        percentage += 5; // Additional 5% for multiple pizzas
     }
     
-    return discount;
+    return totalPrice.percent(percentage);
 }
 
 std::string SeniorDiscount::getStrategyName() const {
@@ -109,14 +110,14 @@ LoyaltyDiscount::LoyaltyDiscount(int customerTier) : tier(customerTier) {
     this->tier = std::max(1, std::min(5, customerTier));
 }
 
-double LoyaltyDiscount::applyDiscount(const PizzaOrders& order) const {
-    double totalPrice = order.getTotalPrice();
+Money LoyaltyDiscount::applyDiscount(const PizzaOrders& order) const {
+    Money totalPrice = order.getTotalPrice();
     
     // Loyalty discount based on customer tier (1-5)
-    // Tier 1: 5%, Tier 2: 8%, Tier 3: 12%, Tier 4: 16%, Tier 5: 20%
-    double discountRate = 0.04 + (tier * 0.04); // 4% base + 4% per tier
+    // Tier 1: 8%, Tier 2: 12%, Tier 3: 16%, Tier 4: 20%, Tier 5: 24%
+    int percentage = 4 + (tier * 4); // 4% base + 4% per tier
     
-    return totalPrice * discountRate;
+    return totalPrice.percent(percentage);
 }
 
 std::string LoyaltyDiscount::getStrategyName() const {
@@ -124,8 +125,8 @@ std::string LoyaltyDiscount::getStrategyName() const {
 }
 
 std::string LoyaltyDiscount::getDescription() const {
-    double percentage = (0.04 + (tier * 0.04)) * 100;
-    return std::to_string(static_cast<int>(percentage)) + "% off for loyal customers (Tier " + std::to_string(tier) + ")";
+    int percentage = 4 + (tier * 4);
+    return std::to_string(percentage) + "% off for loyal customers (Tier " + std::to_string(tier) + ")";
 }
 
 int LoyaltyDiscount::getTier() const {
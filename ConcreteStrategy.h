@@ -6,35 +6,35 @@
 
 class RegularPrice : public DiscountStrategy {
 public:
-    double applyDiscount(const PizzaOrders& order) const override;
+    Money applyDiscount(const PizzaOrders& order) const override;
     std::string getStrategyName() const override;
     std::string getDescription() const override;
 };
 
 class FamilyDiscount : public DiscountStrategy {
 public:
-    double applyDiscount(const PizzaOrders& order) const override;
+    Money applyDiscount(const PizzaOrders& order) const override;
     std::string getStrategyName() const override;
     std::string getDescription() const override;
 };
 
 class BulkDiscount : public DiscountStrategy {
 public:
-    double applyDiscount(const PizzaOrders& order) const override;
+    Money applyDiscount(const PizzaOrders& order) const override;
     std::string getStrategyName() const override;
     std::string getDescription() const override;
 };
 
 class StudentDiscount : public DiscountStrategy {
 public:
-    double applyDiscount(const PizzaOrders& order) const override;
+    Money applyDiscount(const PizzaOrders& order) const override;
     std::string getStrategyName() const override;
     std::string getDescription() const override;
 };
 
 class SeniorDiscount : public DiscountStrategy {
 public:
-    double applyDiscount(const PizzaOrders& order) const override;
+    Money applyDiscount(const PizzaOrders& order) const override;
     std::string getStrategyName() const override;
     std::string getDescription() const override;
 };
@@ -46,7 +46,7 @@ private:
 public:
     explicit LoyaltyDiscount(int customerTier = 1);
     
-    double applyDiscount(const PizzaOrders& order) const override;
+    Money applyDiscount(const PizzaOrders& order) const override;
     std::string getStrategyName() const override;
     std::string getDescription() const override;
     
@@ -1,29 +1,29 @@
 #include "Customer.h"
-#include <iostream>
 
 Customer::Customer(const std::string& name, const std::string& phone): customerName(name), phoneNumber(phone){
 }
 
 void Customer::update(const std::string& message){
     notifications.push_back(message);
+    Document document(*outputSink);
     
-    std::cout << "\nCustomer Notification: " << customerName << std::endl;
-    std::cout << "Received: " << message << std::endl;
+    document << "\nCustomer Notification: " << customerName << '\n';
+    document << "Received: " << message << '\n';
     
     if(!phoneNumber.empty()){
-        std::cout << "SMS sent to " << phoneNumber << std::endl;
+        document << "SMS sent to " << phoneNumber << '\n';
     }
     
     if(message.find("NEW PIZZA") != std::string::npos){
-        std::cout << customerName << " says: 'Exciting!'" << std::endl;
+        document << customerName << " says: 'Exciting!'\n";
     } 
     
     else if(message.find("SPECIAL OFFER") != std::string::npos){
-        std::cout << customerName << " says: 'I should order soon!'" << std::endl;
+        document << customerName << " says: 'I should order soon!'\n";
     } 
     
     else if(message.find("REMOVED") != std::string::npos || message.find("ENDED") != std::string::npos){
-        std::cout << customerName << " says: 'Oh no!'" << std::endl;
+        document << customerName << " says: 'Oh no!'\n";
     }
 }
 
@@ -47,17 +47,18 @@ void Customer::clearNotifications(){
     notifications.clear();
 }
 
-void Customer::displayNotifications() const{
-    std::cout << "\n=== Notifications for " << customerName << " ===" << std::endl;
+void Customer::displayNotifications(OutputSink& sink) const{
+    Document document(sink);
+    document << "\n=== Notifications for " << customerName << " ===\n";
 
     if(notifications.empty()){
-        std::cout << "No notifications." << std::endl;
+        document << "No notifications.\n";
     } 
     
     else{
         for(size_t i = 0; i < notifications.size(); ++i){
-            std::cout << (i + 1) << ". " << notifications[i] << std::endl;
+            document << (i + 1) << ". " << notifications[i] << '\n';
         }
     }
-    std::cout << "=====================================" << std::endl;
-}
\ No newline at end of file
+    document << "=====================================\n";
+}
\ No newline at end of file
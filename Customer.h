@@ -21,7 +21,7 @@ public:
     
     std::vector<std::string> getNotifications() const;
     void clearNotifications();
-    void displayNotifications() const;
+    void displayNotifications(OutputSink& sink = OutputSink::console()) const;
 };
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "PizzaOrders.h"
 #include "Topping.h"
+#include "RecipeRegistry.h"
 #include "ConcreteStrategy.h"
 #include <iostream>
 #include <string>
@@ -424,6 +425,9 @@ void displayDemoMenu() {
 int main() {
     int choice;
     
+    // Recipes are data; the defaults are used if the file is missing
+    RecipeRegistry::loadFromFile("recipes.txt");
+    
     while (true) {
         displayDemoMenu();
         std::cin >> choice;
@@ -2,12 +2,13 @@
 #define DISCOUNTSTRATEGY_H
 
 class PizzaOrders;
+#include "Money.h"
 #include <string>
 
 class DiscountStrategy {
 public:
     virtual ~DiscountStrategy() = default;
-    virtual double applyDiscount(const PizzaOrders& order) const = 0;
+    virtual Money applyDiscount(const PizzaOrders& order) const = 0;
     virtual std::string getStrategyName() const = 0;
     virtual std::string getDescription() const = 0;
 };
@@ -1,29 +1,12 @@
 #include "ExtraCheese.h"
-#include <iostream>
 
-const double ExtraCheese::EXTRA_CHEESE_PRICE = 12.00;
+constexpr Money ExtraCheese::EXTRA_CHEESE_PRICE;
 
-ExtraCheese::ExtraCheese(Pizza* pizzaToDecorate) : PizzaDecorator(pizzaToDecorate) {
+ExtraCheese::ExtraCheese(Pizza* pizzaToDecorate) : PizzaDecorator(pizzaToDecorate, EXTRA_CHEESE) {
 }
 
-double ExtraCheese::getPrice() {
-    return PizzaDecorator::getPrice() + EXTRA_CHEESE_PRICE;
-}
-
-std::string ExtraCheese::getName() {
-    return PizzaDecorator::getName() + " + Extra Cheese";
-}
-
-void ExtraCheese::printPizza() {
-    std::cout << "Pizza with Extra Cheese: " << getName() << std::endl;
-    std::cout << "Price: R" << getPrice() << std::endl;
-}
-
-double ExtraCheese::getExtraCheesePrice() {
-    return EXTRA_CHEESE_PRICE;
-}
-
-Pizza* ExtraCheese::clone() const {
-    Pizza* clonedWrappedPizza = pizza->clone();
-    return new ExtraCheese(clonedWrappedPizza);
+Pizza* ExtraCheese::cloneInto(MemoryResource& resource) const {
+    ExtraCheese* copy = new (resource) ExtraCheese(owned != nullptr ? owned->cloneInto(resource) : nullptr);
+    copy->copyModifiers(*this);
+    return copy;
 }
\ No newline at end of file
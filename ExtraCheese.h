@@ -4,23 +4,23 @@
 #include "PizzaDecorator.h"
 #include <string>
 
-// Concrete decorator for adding extra cheese to a pizza
+// Concrete decorator for adding extra cheese to a pizza (adds EXTRA_CHEESE
+// to the pizza's modifier set)
 class ExtraCheese : public PizzaDecorator {
 private:
-    static const double EXTRA_CHEESE_PRICE;
+    static constexpr Money EXTRA_CHEESE_PRICE =
+        Money::fromCents(ToppingCatalog::DEFAULT_MODIFIERS[EXTRA_CHEESE].cents);
 
 public:
     ExtraCheese(Pizza* pizzaToDecorate);
     virtual ~ExtraCheese() = default;
     
-    virtual double getPrice() override;
-    virtual std::string getName() override;
-    virtual void printPizza() override;
+    // Clones stay ExtraCheese objects
+    virtual Pizza* cloneInto(MemoryResource& resource) const override;
     
-    // Static method to get the extra cheese price
-    static double getExtraCheesePrice();
-
-    virtual Pizza* clone() const override;
+    // Static method to get the default extra cheese price (usable at compile
+    // time; the active catalog may reprice it)
+    static constexpr Money getExtraCheesePrice() { return EXTRA_CHEESE_PRICE; }
 };
 
-#endif
\ No newline at end of file
+#endif
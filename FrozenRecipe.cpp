@@ -0,0 +1,435 @@
+#include "FrozenRecipe.h"
+#include "Topping.h"
+#include "ToppingGroup.h"
+#include "BasePizza.h"
+#include "PizzaDecorator.h"
+#include "PizzaName.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // Serialised layout: header followed by the node arrays, the name pool
+    // and the modifiers (subtree ends are recomputed from the depths)
+    struct SerialHeader {
+        char magic[4];
+        uint32_t nodeCount;
+        uint32_t namePoolSize;
+        uint32_t modifierCount;
+        uint64_t catalogVersion;
+    };
+
+    const char SERIAL_MAGIC[4] = {'F', 'R', 'Z', '2'};
+
+    template <typename T>
+    void appendArray(std::string& out, const std::vector<T>& values) {
+        if (!values.empty()) {
+            out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        }
+    }
+
+    template <typename T>
+    bool readArray(const std::string& data, size_t& pos, size_t count, std::vector<T>& values) {
+        if (count > (data.size() - pos) / sizeof(T)) {
+            return false;
+        }
+        values.resize(count);
+        if (count != 0) {
+            std::memcpy(&values[0], data.data() + pos, count * sizeof(T));
+        }
+        pos += count * sizeof(T);
+        return true;
+    }
+
+    // FNV-1a
+    const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+    const uint64_t FNV_PRIME = 1099511628211ULL;
+
+    void hashBytes(uint64_t& hash, const void* data, size_t length) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+    }
+}
+
+FrozenRecipe::FrozenRecipe() : catalogVersion(0) {
+}
+
+// ==================== Freezing ====================
+
+bool FrozenRecipe::appendNode(const PizzaComponent* component, uint16_t depth) {
+    uint32_t index = static_cast<uint32_t>(kinds.size());
+
+    if (component->getKind() == PizzaComponent::TOPPING) {
+        const Topping* topping = static_cast<const Topping*>(component);
+        kinds.push_back(TOPPING);
+        toppingIds.push_back(topping->getId());
+        prices.push_back(topping->getPrice().getCents());
+        quantities.push_back(topping->getQuantity());
+        depths.push_back(depth);
+        subtreeEnds.push_back(index + 1);
+        nameOffsets.push_back(static_cast<uint32_t>(namePool.size()));
+        if (topping->getId() == ToppingCatalog::INVALID_ID) {
+            // Unknown toppings keep their own name
+            std::string toppingName = topping->getToppingName();
+            namePool += toppingName;
+            nameLengths.push_back(static_cast<uint32_t>(toppingName.size()));
+        } else {
+            nameLengths.push_back(0);
+        }
+        return true;
+    }
+
+    if (component->getKind() != PizzaComponent::GROUP || depth == UINT16_MAX) {
+        return false;
+    }
+    const ToppingGroup* group = static_cast<const ToppingGroup*>(component);
+
+    kinds.push_back(GROUP);
+    toppingIds.push_back(ToppingCatalog::INVALID_ID);
+    prices.push_back(0);
+    quantities.push_back(1);
+    depths.push_back(depth);
+    subtreeEnds.push_back(0);  // Filled in once the children are appended
+    nameOffsets.push_back(static_cast<uint32_t>(namePool.size()));
+    nameLengths.push_back(static_cast<uint32_t>(group->getGroupName().size()));
+    namePool += group->getGroupName();
+
+    for (const auto& child : group->getComponents()) {
+        if (!appendNode(child, static_cast<uint16_t>(depth + 1))) {
+            return false;
+        }
+    }
+    subtreeEnds[index] = static_cast<uint32_t>(kinds.size());
+    return true;
+}
+
+FrozenRecipe* FrozenRecipe::freeze(const ToppingGroup& group) {
+    // One snapshot for every price stored in the record
+    CatalogScope scope;
+    FrozenRecipe* recipe = new FrozenRecipe();
+    recipe->catalogVersion = scope.catalog().getVersion();
+    if (!recipe->appendNode(&group, 0)) {
+        delete recipe;
+        return nullptr;
+    }
+    return recipe;
+}
+
+FrozenRecipe* FrozenRecipe::freeze(Pizza& pizza) {
+    CatalogScope scope;
+    FrozenRecipe* recipe = new FrozenRecipe();
+    recipe->catalogVersion = scope.catalog().getVersion();
+
+    // Collect the modifier sets (outermost first; one per decorator in a
+    // chain of wrappers)
+    Pizza* current = &pizza;
+    while (PizzaDecorator* decorator = current->asDecorator()) {
+        for (size_t i = decorator->getModifierCount(); i > 0; --i) {
+            recipe->modifiers.push_back(decorator->getModifier(i - 1));
+        }
+        current = decorator->getWrappedPizza();
+        if (current == nullptr) {
+            delete recipe;
+            return nullptr;
+        }
+    }
+    std::reverse(recipe->modifiers.begin(), recipe->modifiers.end());
+
+    BasePizza* base = dynamic_cast<BasePizza*>(current);
+    if (base == nullptr ||
+        (base->getToppings() != nullptr && !recipe->appendNode(base->getToppings(), 0))) {
+        delete recipe;
+        return nullptr;
+    }
+    return recipe;
+}
+
+// ==================== Queries ====================
+
+size_t FrozenRecipe::getNodeCount() const {
+    return kinds.size();
+}
+
+size_t FrozenRecipe::getModifierCount() const {
+    return modifiers.size();
+}
+
+Money FrozenRecipe::getPrice() const {
+    CatalogScope scope;
+    const ToppingCatalog& catalog = scope.catalog();
+
+    int64_t total = 0;
+    if (catalog.getVersion() == catalogVersion) {
+        for (size_t i = 0; i < prices.size(); ++i) {
+            total += prices[i];
+        }
+    } else {
+        for (size_t i = 0; i < kinds.size(); ++i) {
+            if (kinds[i] == TOPPING) {
+                total += toppingIds[i] == ToppingCatalog::INVALID_ID
+                             ? prices[i]
+                             : catalog.getPrice(toppingIds[i]).getCents() * quantities[i];
+            }
+        }
+    }
+
+    Money price = Money::fromCents(total);
+    for (uint8_t modifier : modifiers) {
+        price += catalog.getModifierPrice(static_cast<PizzaModifier>(modifier));
+    }
+    return price;
+}
+
+void FrozenRecipe::writeName(NameWriter& out) const {
+    if (kinds.empty()) {
+        out.append("Empty Pizza");
+    } else {
+        CatalogScope scope;
+        const ToppingCatalog& catalog = scope.catalog();
+
+        for (size_t i = 0; i < kinds.size(); ++i) {
+            // Moving up closes the groups that ended, moving sideways adds a separator
+            if (i > 0 && depths[i] <= depths[i - 1]) {
+                for (uint16_t level = depths[i]; level < depths[i - 1]; ++level) {
+                    out.append(")");
+                }
+                out.append(", ");
+            }
+
+            if (kinds[i] == TOPPING && toppingIds[i] != ToppingCatalog::INVALID_ID) {
+                size_t length = 0;
+                const char* data = catalog.getNameData(toppingIds[i], length);
+                out.append(data, length);
+            } else {
+                out.append(namePool.data() + nameOffsets[i], nameLengths[i]);
+            }
+            if (quantities[i] > 1) {
+                out.append(" x");
+                out.appendNumber(quantities[i]);
+            }
+
+            if (kinds[i] == GROUP && subtreeEnds[i] > i + 1) {
+                out.append(" (");
+            }
+        }
+        for (uint16_t level = depths[0]; level < depths.back(); ++level) {
+            out.append(")");
+        }
+    }
+
+    for (uint8_t modifier : modifiers) {
+        const char* modifierName = ToppingCatalog::getModifierName(static_cast<PizzaModifier>(modifier));
+        out.append(" + ");
+        out.append(modifierName, std::strlen(modifierName));
+    }
+}
+
+std::string FrozenRecipe::getName() const {
+    CatalogScope scope;
+    NameWriter counter;
+    writeName(counter);
+    std::string result(counter.size(), '\0');
+    NameWriter writer(&result[0], result.size());
+    writeName(writer);
+    return result;
+}
+
+uint64_t FrozenRecipe::hash() const {
+    uint64_t result = FNV_OFFSET;
+    for (size_t i = 0; i < kinds.size(); ++i) {
+        hashBytes(result, &kinds[i], sizeof(kinds[i]));
+        hashBytes(result, &toppingIds[i], sizeof(toppingIds[i]));
+        hashBytes(result, &quantities[i], sizeof(quantities[i]));
+        hashBytes(result, &depths[i], sizeof(depths[i]));
+        hashBytes(result, &nameLengths[i], sizeof(nameLengths[i]));
+        hashBytes(result, namePool.data() + nameOffsets[i], nameLengths[i]);
+    }
+    uint32_t modifierCount = static_cast<uint32_t>(modifiers.size());
+    hashBytes(result, &modifierCount, sizeof(modifierCount));
+    if (!modifiers.empty()) {
+        hashBytes(result, modifiers.data(), modifiers.size());
+    }
+    return result;
+}
+
+PizzaFingerprint FrozenRecipe::getFingerprint() const {
+    PizzaFingerprint result;
+    for (size_t i = 0; i < kinds.size(); ++i) {
+        if (kinds[i] != TOPPING) {
+            continue;
+        }
+        if (toppingIds[i] != ToppingCatalog::INVALID_ID) {
+            result += PizzaFingerprint::ofTopping(toppingIds[i], quantities[i]);
+        } else {
+            result += PizzaFingerprint::ofTopping(namePool.data() + nameOffsets[i], nameLengths[i], quantities[i]);
+        }
+    }
+    for (uint8_t modifier : modifiers) {
+        result += PizzaFingerprint::ofModifier(static_cast<PizzaModifier>(modifier));
+    }
+    return result;
+}
+
+// ==================== Serialisation ====================
+
+std::string FrozenRecipe::serialize() const {
+    SerialHeader header;
+    std::memcpy(header.magic, SERIAL_MAGIC, sizeof(header.magic));
+    header.nodeCount = static_cast<uint32_t>(kinds.size());
+    header.namePoolSize = static_cast<uint32_t>(namePool.size());
+    header.modifierCount = static_cast<uint32_t>(modifiers.size());
+    header.catalogVersion = catalogVersion;
+
+    std::string out;
+    out.reserve(sizeof(header) + kinds.size() * (sizeof(uint8_t) + sizeof(ToppingId) + sizeof(int64_t) +
+                                                 sizeof(uint16_t) + 3 * sizeof(uint32_t)) +
+                namePool.size() + modifiers.size());
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    appendArray(out, kinds);
+    appendArray(out, toppingIds);
+    appendArray(out, prices);
+    appendArray(out, quantities);
+    appendArray(out, depths);
+    appendArray(out, nameOffsets);
+    appendArray(out, nameLengths);
+    out += namePool;
+    appendArray(out, modifiers);
+    return out;
+}
+
+bool FrozenRecipe::computeSubtreeEnds() {
+    size_t count = kinds.size();
+    subtreeEnds.assign(count, static_cast<uint32_t>(count));
+    if (count == 0) {
+        return true;
+    }
+    if (depths[0] != 0) {
+        return false;
+    }
+
+    // Open groups, innermost last; a node closes every group at its depth or deeper
+    std::vector<uint32_t> open;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (i > 0 && (depths[i] == 0 || depths[i] > depths[i - 1] + 1 ||
+                      (depths[i] > depths[i - 1] && kinds[i - 1] != GROUP))) {
+            return false;
+        }
+        while (!open.empty() && depths[open.back()] >= depths[i]) {
+            subtreeEnds[open.back()] = i;
+            open.pop_back();
+        }
+        if (kinds[i] == GROUP) {
+            open.push_back(i);
+        } else {
+            subtreeEnds[i] = i + 1;
+        }
+    }
+    return true;
+}
+
+FrozenRecipe* FrozenRecipe::deserialize(const std::string& data) {
+    SerialHeader header;
+    if (data.size() < sizeof(header)) {
+        return nullptr;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, SERIAL_MAGIC, sizeof(header.magic)) != 0) {
+        return nullptr;
+    }
+
+    // Catalog versions are only meaningful in the process that wrote the
+    // blob, so a thawed recipe always prices from the catalog (versions start at 1)
+    CatalogScope scope;
+    const int64_t catalogSize = static_cast<int64_t>(scope.catalog().size());
+    FrozenRecipe* recipe = new FrozenRecipe();
+    recipe->catalogVersion = 0;
+    size_t pos = sizeof(header);
+    bool valid = readArray(data, pos, header.nodeCount, recipe->kinds) &&
+                 readArray(data, pos, header.nodeCount, recipe->toppingIds) &&
+                 readArray(data, pos, header.nodeCount, recipe->prices) &&
+                 readArray(data, pos, header.nodeCount, recipe->quantities) &&
+                 readArray(data, pos, header.nodeCount, recipe->depths) &&
+                 readArray(data, pos, header.nodeCount, recipe->nameOffsets) &&
+                 readArray(data, pos, header.nodeCount, recipe->nameLengths) &&
+                 header.namePoolSize <= data.size() - pos;
+    if (valid) {
+        recipe->namePool.assign(data, pos, header.namePoolSize);
+        pos += header.namePoolSize;
+        valid = readArray(data, pos, header.modifierCount, recipe->modifiers) &&
+                pos == data.size() && recipe->computeSubtreeEnds();
+    }
+
+    for (uint32_t i = 0; valid && i < header.nodeCount; ++i) {
+        valid = recipe->kinds[i] <= GROUP && recipe->quantities[i] != 0 &&
+                (recipe->toppingIds[i] == ToppingCatalog::INVALID_ID ||
+                 (recipe->toppingIds[i] >= 0 && recipe->toppingIds[i] < catalogSize)) &&
+                recipe->nameOffsets[i] <= recipe->namePool.size() &&
+                recipe->nameLengths[i] <= recipe->namePool.size() - recipe->nameOffsets[i];
+    }
+    for (uint32_t i = 0; valid && i < header.modifierCount; ++i) {
+        valid = recipe->modifiers[i] < PIZZA_MODIFIER_COUNT;
+    }
+
+    if (!valid) {
+        delete recipe;
+        return nullptr;
+    }
+
+    // Toppings unknown to the catalog are priced at zero, as they are when built
+    recipe->prices.assign(header.nodeCount, 0);
+    return recipe;
+}
+
+// ==================== Thawing ====================
+
+std::string FrozenRecipe::storedName(uint32_t index) const {
+    return namePool.substr(nameOffsets[index], nameLengths[index]);
+}
+
+ToppingGroup* FrozenRecipe::buildGroup(uint32_t index) const {
+    ToppingGroup* group = new ToppingGroup(storedName(index));
+    for (uint32_t child = index + 1; child < subtreeEnds[index]; child = subtreeEnds[child]) {
+        if (kinds[child] == GROUP) {
+            group->addComponent(buildGroup(child));
+        } else if (toppingIds[child] != ToppingCatalog::INVALID_ID) {
+            group->addTopping(toppingIds[child], quantities[child]);
+        } else {
+            group->addComponent(new Topping(storedName(child), quantities[child]));
+        }
+    }
+    return group;
+}
+
+ToppingGroup* FrozenRecipe::toGroup() const {
+    if (kinds.empty() || kinds[0] != GROUP) {
+        return nullptr;
+    }
+    return buildGroup(0);
+}
+
+Pizza* FrozenRecipe::toPizza() const {
+    PizzaComponent* root = nullptr;
+    if (!kinds.empty()) {
+        if (kinds[0] == GROUP) {
+            root = buildGroup(0);
+        } else if (toppingIds[0] != ToppingCatalog::INVALID_ID) {
+            root = new Topping(toppingIds[0], quantities[0]);
+        } else {
+            root = new Topping(storedName(0), quantities[0]);
+        }
+    }
+
+    // One decorator holds every modifier (another wraps it if the set is full)
+    Pizza* pizza = new BasePizza(root);
+    PizzaDecorator* decorator = nullptr;
+    for (uint8_t modifier : modifiers) {
+        if (decorator == nullptr || !decorator->addModifier(static_cast<PizzaModifier>(modifier))) {
+            decorator = new PizzaDecorator(pizza);
+            decorator->addModifier(static_cast<PizzaModifier>(modifier));
+            pizza = decorator;
+        }
+    }
+    return pizza;
+}
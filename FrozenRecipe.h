@@ -0,0 +1,110 @@
+#ifndef FROZENRECIPE_H
+#define FROZENRECIPE_H
+
+#include "Money.h"
+#include "ToppingCatalog.h"
+#include "PizzaFingerprint.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class Pizza;
+class PizzaComponent;
+class ToppingGroup;
+class NameWriter;
+
+// Immutable, flattened copy of a pizza's composite tree. Nodes are stored in
+// pre-order as parallel arrays (structure of arrays), so pricing, naming,
+// hashing and serialisation are linear scans over contiguous memory instead
+// of virtual calls through heap nodes. Decorators are kept as a list of
+// modifiers applied around the tree.
+//
+// A frozen recipe is read-only; thaw it with toGroup()/toPizza() to edit it.
+class FrozenRecipe {
+    // Reads the topping arrays directly to price many recipes at once
+    friend class PriceBatch;
+
+public:
+    enum NodeKind : uint8_t {
+        TOPPING = 0,
+        GROUP = 1
+    };
+
+private:
+    // One entry per node, in pre-order
+    std::vector<uint8_t> kinds;
+    std::vector<ToppingId> toppingIds;   // INVALID_ID for groups and unknown toppings
+    std::vector<int64_t> prices;         // Cents at freeze time, all portions (0 for groups)
+    std::vector<uint32_t> quantities;    // Portions of a topping (1 for groups)
+    std::vector<uint16_t> depths;        // 0 for the root
+    std::vector<uint32_t> subtreeEnds;   // One past the last node of the node's subtree
+    std::vector<uint32_t> nameOffsets;   // Into namePool (group names and unknown toppings)
+    std::vector<uint32_t> nameLengths;
+    std::string namePool;
+
+    // PizzaModifier values of the decorators, innermost first
+    std::vector<uint8_t> modifiers;
+
+    // Catalog version the stored prices belong to
+    unsigned long catalogVersion;
+
+    FrozenRecipe();
+
+    // Append a component and its subtree; returns false for unsupported types
+    bool appendNode(const PizzaComponent* component, uint16_t depth);
+
+    // Recompute subtreeEnds from depths; returns false if the depths don't
+    // describe a single pre-order tree
+    bool computeSubtreeEnds();
+
+    // Name stored for a node (empty for toppings known to the catalog)
+    std::string storedName(uint32_t index) const;
+
+    // Rebuild the group starting at node index
+    ToppingGroup* buildGroup(uint32_t index) const;
+
+public:
+    // Freeze a composite tree. Returns nullptr if it contains component
+    // types the flat layout doesn't know.
+    static FrozenRecipe* freeze(const ToppingGroup& group);
+
+    // Freeze a pizza including its decorators. Returns nullptr for pizza or
+    // decorator types the flat layout doesn't know.
+    static FrozenRecipe* freeze(Pizza& pizza);
+
+    // Rebuild a recipe written by serialize(). Returns nullptr on bad input,
+    // including topping IDs outside the active catalog. The stored prices are
+    // dropped: catalog versions are per process, so the rebuilt recipe prices
+    // its toppings from the active catalog, and toppings the catalog doesn't
+    // know at zero.
+    static FrozenRecipe* deserialize(const std::string& data);
+
+    // Number of nodes in the tree (0 for an empty pizza)
+    size_t getNodeCount() const;
+    size_t getModifierCount() const;
+
+    // Price with the active catalog. Uses the prices stored at freeze time
+    // when the catalog hasn't changed, otherwise looks the IDs up again.
+    Money getPrice() const;
+
+    // Same name the original pizza renders
+    void writeName(NameWriter& out) const;
+    std::string getName() const;
+
+    // Content hash (FNV-1a) of the structure, toppings, names and
+    // modifiers; independent of prices and catalog version
+    uint64_t hash() const;
+
+    // Canonical fingerprint, equal to the original pizza's getFingerprint()
+    PizzaFingerprint getFingerprint() const;
+
+    // Compact binary form (host byte order, for caches and IPC on one machine)
+    std::string serialize() const;
+
+    // Thaw into mutable objects (owned by the caller). toGroup() returns
+    // nullptr if the root is not a group.
+    ToppingGroup* toGroup() const;
+    Pizza* toPizza() const;
+};
+
+#endif
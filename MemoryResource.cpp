@@ -0,0 +1,180 @@
+#include "MemoryResource.h"
+#include <new>
+#include <cstdint>
+#include <type_traits>
+
+// AddressSanitizer builds mark the part of a chunk an arena has taken back
+// with reset(), so a pizza used after its order was reset is reported
+// instead of read from reused memory
+#if defined(__SANITIZE_ADDRESS__)
+#define ARENA_CHECKS_RESET 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define ARENA_CHECKS_RESET 1
+#endif
+#endif
+
+#ifdef ARENA_CHECKS_RESET
+#include <sanitizer/asan_interface.h>
+#define ARENA_RETIRE(pointer, size) ASAN_POISON_MEMORY_REGION(pointer, size)
+#define ARENA_REUSE(pointer, size) ASAN_UNPOISON_MEMORY_REGION(pointer, size)
+#else
+#define ARENA_RETIRE(pointer, size) ((void)(pointer), (void)(size))
+#define ARENA_REUSE(pointer, size) ((void)(pointer), (void)(size))
+#endif
+
+namespace {
+    class HeapResource : public MemoryResource {
+    public:
+        void* allocate(size_t bytes, size_t alignment) override {
+            (void)alignment;  // operator new is aligned for any fundamental type
+            return ::operator new(bytes);
+        }
+
+        void deallocate(void* pointer, size_t bytes, size_t alignment) override {
+            (void)bytes;
+            (void)alignment;
+            ::operator delete(pointer);
+        }
+    };
+
+    // Stored in front of every ResourceAllocated object
+    struct AllocationHeader {
+        MemoryResource* resource;
+        size_t size;
+    };
+
+    const size_t ALLOCATION_ALIGNMENT = alignof(std::max_align_t);
+
+    // Header size rounded up so the object after it stays aligned
+    const size_t HEADER_SIZE =
+        (sizeof(AllocationHeader) + ALLOCATION_ALIGNMENT - 1) / ALLOCATION_ALIGNMENT * ALLOCATION_ALIGNMENT;
+
+    void* allocateWithHeader(size_t size, MemoryResource& resource) {
+        char* block = static_cast<char*>(resource.allocate(HEADER_SIZE + size, ALLOCATION_ALIGNMENT));
+        AllocationHeader* header = reinterpret_cast<AllocationHeader*>(block);
+        header->resource = &resource;
+        header->size = size;
+        return block + HEADER_SIZE;
+    }
+}
+
+// ==================== MemoryResource ====================
+
+MemoryResource& MemoryResource::heap() {
+    // Never destroyed: objects in other statics (such as the catalog's
+    // interned toppings) may still be deleted through it during shutdown
+    static std::aligned_storage<sizeof(HeapResource), alignof(HeapResource)>::type storage;
+    static HeapResource* resource = new (&storage) HeapResource();
+    return *resource;
+}
+
+// ==================== MonotonicArena ====================
+
+MonotonicArena::MonotonicArena(size_t initialChunkSize)
+    : current(nullptr), remaining(0), initialChunkSize(initialChunkSize),
+      nextChunkSize(initialChunkSize), newestChunkSize(0), bytesUsed(0), bytesReserved(0) {
+}
+
+MonotonicArena::~MonotonicArena() {
+    release();
+}
+
+void* MonotonicArena::allocate(size_t bytes, size_t alignment) {
+    size_t padding = (alignment - reinterpret_cast<uintptr_t>(current) % alignment) % alignment;
+    if (current == nullptr || padding + bytes > remaining) {
+        // Start a new chunk, doubling the size so large orders need few chunks
+        size_t chunkSize = nextChunkSize;
+        while (chunkSize < bytes + alignment) {
+            chunkSize *= 2;
+        }
+        nextChunkSize = chunkSize * 2;
+        current = static_cast<char*>(::operator new(chunkSize));
+        remaining = chunkSize;
+        chunks.push_back(current);
+        newestChunkSize = chunkSize;
+        bytesReserved += chunkSize;
+        padding = (alignment - reinterpret_cast<uintptr_t>(current) % alignment) % alignment;
+    }
+
+    char* result = current + padding;
+    current = result + bytes;
+    remaining -= padding + bytes;
+    bytesUsed += bytes;
+    ARENA_REUSE(result, bytes);
+    return result;
+}
+
+void MonotonicArena::deallocate(void* pointer, size_t bytes, size_t alignment) {
+    // Memory is only returned by release()
+    (void)pointer;
+    (void)bytes;
+    (void)alignment;
+}
+
+void MonotonicArena::release() {
+    if (!chunks.empty()) {
+        ARENA_REUSE(chunks.back(), newestChunkSize);
+    }
+    for (void* chunk : chunks) {
+        ::operator delete(chunk);
+    }
+    chunks.clear();
+    current = nullptr;
+    remaining = 0;
+    nextChunkSize = initialChunkSize;
+    newestChunkSize = 0;
+    bytesUsed = 0;
+    bytesReserved = 0;
+}
+
+void MonotonicArena::reset() {
+    if (chunks.empty()) {
+        return;
+    }
+    for (size_t i = 0; i + 1 < chunks.size(); ++i) {
+        ::operator delete(chunks[i]);
+    }
+    chunks.erase(chunks.begin(), chunks.end() - 1);
+    current = static_cast<char*>(chunks.back());
+    remaining = newestChunkSize;
+    bytesUsed = 0;
+    bytesReserved = newestChunkSize;
+    ARENA_RETIRE(current, newestChunkSize);
+}
+
+size_t MonotonicArena::getBytesUsed() const {
+    return bytesUsed;
+}
+
+size_t MonotonicArena::getBytesReserved() const {
+    return bytesReserved;
+}
+
+size_t MonotonicArena::getChunkCount() const {
+    return chunks.size();
+}
+
+// ==================== ResourceAllocated ====================
+
+void* ResourceAllocated::operator new(size_t size) {
+    return allocateWithHeader(size, MemoryResource::heap());
+}
+
+void* ResourceAllocated::operator new(size_t size, MemoryResource& resource) {
+    return allocateWithHeader(size, resource);
+}
+
+void ResourceAllocated::operator delete(void* pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+    char* block = static_cast<char*>(pointer) - HEADER_SIZE;
+    AllocationHeader* header = reinterpret_cast<AllocationHeader*>(block);
+    header->resource->deallocate(block, HEADER_SIZE + header->size, ALLOCATION_ALIGNMENT);
+}
+
+void ResourceAllocated::operator delete(void* pointer, MemoryResource& resource) {
+    (void)resource;  // The header already names it
+    operator delete(pointer);
+}
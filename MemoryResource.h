@@ -0,0 +1,75 @@
+#ifndef MEMORYRESOURCE_H
+#define MEMORYRESOURCE_H
+
+#include <cstddef>
+#include <vector>
+
+// Source of memory for pizza objects (a small C++11 stand-in for
+// std::pmr::memory_resource)
+class MemoryResource {
+public:
+    virtual ~MemoryResource() = default;
+
+    virtual void* allocate(size_t bytes, size_t alignment) = 0;
+    virtual void deallocate(void* pointer, size_t bytes, size_t alignment) = 0;
+
+    // The global heap (the default everywhere)
+    static MemoryResource& heap();
+};
+
+// Monotonic arena: allocation bumps a pointer inside large chunks,
+// deallocate does nothing, and all memory is returned in one step when the
+// arena is released or destroyed. Not thread-safe; meant for memory with
+// one owner, such as all the pizzas of one order.
+class MonotonicArena : public MemoryResource {
+private:
+    std::vector<void*> chunks;
+    char* current;      // Next free byte in the newest chunk
+    size_t remaining;   // Free bytes left in the newest chunk
+    size_t initialChunkSize;
+    size_t nextChunkSize;
+    size_t newestChunkSize;
+    size_t bytesUsed;
+    size_t bytesReserved;   // Total size of the chunks held
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+public:
+    explicit MonotonicArena(size_t initialChunkSize = 1024);
+    ~MonotonicArena();
+
+    void* allocate(size_t bytes, size_t alignment) override;
+    void deallocate(void* pointer, size_t bytes, size_t alignment) override;
+
+    // Free every chunk and start again from the initial chunk size. Objects
+    // allocated from the arena must already be destroyed.
+    void release();
+
+    // Like release(), but keeps the newest (largest) chunk so an arena that
+    // is reused for similar work doesn't allocate again. AddressSanitizer
+    // builds report any later use of the objects the chunk held.
+    void reset();
+
+    // Bytes handed out since the last release or reset, bytes held in
+    // chunks, and the number of chunks
+    size_t getBytesUsed() const;
+    size_t getBytesReserved() const;
+    size_t getChunkCount() const;
+};
+
+// Base for classes whose objects can be created in a MemoryResource:
+//   new (resource) BasePizza(...)
+// A plain new allocates from the heap. Each allocation records its resource
+// in a small header, so delete always returns the memory to the right place.
+class ResourceAllocated {
+public:
+    static void* operator new(size_t size);
+    static void* operator new(size_t size, MemoryResource& resource);
+    static void operator delete(void* pointer);
+
+    // Only used if a constructor throws during new (resource)
+    static void operator delete(void* pointer, MemoryResource& resource);
+};
+
+#endif
@@ -26,24 +26,35 @@ void Menus::removeObserver(Observer* observer){
     }
 }
 
+void Menus::setOutputSink(OutputSink& sink){
+    outputSink = &sink;
+}
+
 void Menus::addPizza(Pizza* pizza){
     if(pizza != nullptr){
-        pizzas.push_back(pizza);
+        pizzas.emplace_back(pizza);
     }
 }
 
 void Menus::removePizza(Pizza* pizza){
     if(pizza != nullptr){
-        auto it = std::find(pizzas.begin(), pizzas.end(), pizza);
+        auto it = std::find_if(pizzas.begin(), pizzas.end(),
+                               [pizza](const PizzaHandle& handle){ return handle.get() == pizza; });
 
         if(it != pizzas.end()){
+            it->release();  // The caller owns it again
             pizzas.erase(it);
         }
     }
 }
 
 std::vector<Pizza*> Menus::getPizzas() const{
-    return pizzas;
+    std::vector<Pizza*> view;
+    view.reserve(pizzas.size());
+    for(const PizzaHandle& pizza : pizzas){
+        view.push_back(pizza.get());
+    }
+    return view;
 }
 
 int Menus::getPizzaCount() const{
@@ -51,9 +62,5 @@ int Menus::getPizzaCount() const{
 }
 
 void Menus::clearPizzas(){
-    for(auto* pizza : pizzas){
-        delete pizza;
-    }
-    
     pizzas.clear();
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -2,24 +2,39 @@
 #define MENUS_H
 #include "Observer.h"
 #include "Pizza.h"
+#include "PizzaHandle.h"
+#include "OutputSink.h"
 #include <vector>
 #include <string>
 
 class Menus{
 protected:
     std::vector<Observer*> observers;
-    std::vector<Pizza*> pizzas;
+    std::vector<PizzaHandle> pizzas;
+    
+    // Where broadcasts are printed (the console unless redirected)
+    OutputSink* outputSink = &OutputSink::console();
 
 public:
+    Menus() = default;
     virtual ~Menus();
+    
+    // Menus own their pizzas, so they move but don't copy
+    Menus(Menus&& other) = default;
+    Menus& operator=(Menus&& other) = default;
     void addObserver(Observer* observer);
     void removeObserver(Observer* observer);
     
+    // The menu takes ownership of added pizzas; removePizza hands it back.
+    // Handles hold pizzas by pointer, so their addresses stay valid while
+    // the menu grows or moves (specials are keyed by them).
     virtual void addPizza(Pizza* pizza);
     virtual void removePizza(Pizza* pizza);
     
     virtual void notifyObservers(const std::string& message) = 0;
+    void setOutputSink(OutputSink& sink);
     
+    // Borrowed pointers, valid until the menu's pizzas change
     std::vector<Pizza*> getPizzas() const;
     int getPizzaCount() const;
     
@@ -27,4 +42,4 @@ protected:
     void clearPizzas();
 };
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
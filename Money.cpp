@@ -0,0 +1,73 @@
+#include "Money.h"
+#include <cctype>
+
+bool Money::parse(const std::string& text, Money& result) {
+    size_t pos = 0;
+    bool negative = false;
+    if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+        negative = text[pos] == '-';
+        ++pos;
+    }
+
+    // Whole rands (at least one digit, bounded so the cents can't overflow)
+    int64_t rands = 0;
+    size_t digits = 0;
+    while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) {
+        if (++digits > 15) {
+            return false;
+        }
+        rands = rands * 10 + (text[pos] - '0');
+        ++pos;
+    }
+    if (digits == 0) {
+        return false;
+    }
+
+    // Optional fraction with one or two digits
+    int64_t fraction = 0;
+    if (pos < text.size() && text[pos] == '.') {
+        ++pos;
+        size_t fractionDigits = 0;
+        while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) {
+            if (++fractionDigits > 2) {
+                return false;
+            }
+            fraction = fraction * 10 + (text[pos] - '0');
+            ++pos;
+        }
+        if (fractionDigits == 0) {
+            return false;
+        }
+        if (fractionDigits == 1) {
+            fraction *= 10;
+        }
+    }
+    if (pos != text.size()) {
+        return false;
+    }
+
+    int64_t amount = rands * 100 + fraction;
+    result = Money(negative ? -amount : amount);
+    return true;
+}
+
+std::string Money::toString() const {
+    // Work on the magnitude as unsigned so the most negative value is safe
+    uint64_t magnitude = cents < 0 ? 0 - static_cast<uint64_t>(cents) : static_cast<uint64_t>(cents);
+    std::string fraction = std::to_string(magnitude % 100);
+    if (fraction.size() < 2) {
+        fraction = "0" + fraction;
+    }
+    return (cents < 0 ? "-" : "") + std::to_string(magnitude / 100) + "." + fraction;
+}
+
+Money Money::percent(int percentage) const {
+    int64_t scaled = cents * percentage;
+    // Integer division truncates towards zero, so bias by half a cent away from zero
+    int64_t rounded = (scaled >= 0 ? scaled + 50 : scaled - 50) / 100;
+    return Money(rounded);
+}
+
+std::ostream& operator<<(std::ostream& out, Money amount) {
+    return out << amount.toString();
+}
@@ -0,0 +1,58 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstdint>
+#include <string>
+#include <ostream>
+
+// Exact currency amount stored as a whole number of cents. All pricing
+// (toppings, decorators, order totals and discounts) uses Money, so sums
+// are integer additions and totals compare exactly.
+class Money {
+private:
+    int64_t cents;
+
+    constexpr explicit Money(int64_t amountInCents) : cents(amountInCents) {}
+
+public:
+    // Zero
+    constexpr Money() : cents(0) {}
+
+    static constexpr Money fromCents(int64_t amountInCents) { return Money(amountInCents); }
+    static constexpr Money fromRands(int64_t rands) { return Money(rands * 100); }
+
+    // Parse a decimal amount such as "12", "12.5" or "12.50" (at most two
+    // decimals, no exponent). Returns false and leaves result alone on bad input.
+    static bool parse(const std::string& text, Money& result);
+
+    constexpr int64_t getCents() const { return cents; }
+
+    // Amount in rands, for display and interop only (never for arithmetic)
+    double toDouble() const { return static_cast<double>(cents) / 100.0; }
+
+    // Amount formatted with two decimals, e.g. "12.50"
+    std::string toString() const;
+
+    // percent% of this amount, rounded half away from zero to the nearest cent
+    Money percent(int percentage) const;
+
+    Money& operator+=(Money other) { cents += other.cents; return *this; }
+    Money& operator-=(Money other) { cents -= other.cents; return *this; }
+
+    constexpr Money operator+(Money other) const { return Money(cents + other.cents); }
+    constexpr Money operator-(Money other) const { return Money(cents - other.cents); }
+    constexpr Money operator-() const { return Money(-cents); }
+    constexpr Money operator*(int64_t count) const { return Money(cents * count); }
+
+    constexpr bool operator==(Money other) const { return cents == other.cents; }
+    constexpr bool operator!=(Money other) const { return cents != other.cents; }
+    constexpr bool operator<(Money other) const { return cents < other.cents; }
+    constexpr bool operator<=(Money other) const { return cents <= other.cents; }
+    constexpr bool operator>(Money other) const { return cents > other.cents; }
+    constexpr bool operator>=(Money other) const { return cents >= other.cents; }
+};
+
+// Writes the amount with two decimals (same as toString)
+std::ostream& operator<<(std::ostream& out, Money amount);
+
+#endif
@@ -1,11 +1,18 @@
 #ifndef OBSERVER_H
 #define OBSERVER_H
+#include "OutputSink.h"
 #include <string>
 
 class Observer{
+protected:
+    // Where notifications are printed (the console unless redirected)
+    OutputSink* outputSink = &OutputSink::console();
+
 public:
     virtual ~Observer() = default;
     virtual void update(const std::string& message) = 0;
+    
+    void setOutputSink(OutputSink& sink){ outputSink = &sink; }
 };
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "OrderLifecycle.h"
+#include "ConcreteStates.h"
+#include "PizzaOrders.h"
+
+constexpr OrderStatusInfo OrderLifecycle::STATUSES[];
+constexpr const char* OrderLifecycle::EVENT_NAMES[];
+constexpr OrderTransition OrderLifecycle::TABLE[][ORDER_EVENT_COUNT];
+
+// ==================== Compile-time checks ====================
+
+namespace {
+    constexpr const OrderTransition& cell(size_t status, size_t event) {
+        return OrderLifecycle::TABLE[status][event];
+    }
+
+    constexpr bool isFinal(size_t status) {
+        return status == COMPLETED || status == CANCELLED;
+    }
+
+    // Actions that don't move leave next at the row's own status
+    constexpr bool staysPut(size_t status, size_t event) {
+        return cell(status, event).moves() || cell(status, event).next == status;
+    }
+
+    // Moves go one step along the lifecycle, or to Cancelled
+    constexpr bool movesForward(size_t status, size_t event) {
+        return !cell(status, event).moves() ||
+               (!isFinal(status) && (cell(status, event).next == CANCELLED || cell(status, event).next == status + 1));
+    }
+
+    // Pizzas can be added and removed exactly where the status says the order can be modified
+    constexpr bool editableMatches(size_t status, size_t event) {
+        return (event != ADD_PIZZA && event != REMOVE_PIZZA) ||
+               (cell(status, event).action != OrderTransition::REJECT) == OrderLifecycle::STATUSES[status].canModify;
+    }
+
+    // Every unfinished order can be cancelled
+    constexpr bool cancellable(size_t status, size_t event) {
+        return event != CANCEL_ORDER || isFinal(status) || OrderLifecycle::next(static_cast<OrderStatus>(status), CANCEL_ORDER) == CANCELLED;
+    }
+
+    constexpr bool cellValid(size_t status, size_t event) {
+        return cell(status, event).next < ORDER_STATUS_COUNT && staysPut(status, event) &&
+               movesForward(status, event) && editableMatches(status, event) && cancellable(status, event);
+    }
+
+    constexpr bool cellsValidFrom(size_t index) {
+        return index == ORDER_STATUS_COUNT * ORDER_EVENT_COUNT ||
+               (cellValid(index / ORDER_EVENT_COUNT, index % ORDER_EVENT_COUNT) && cellsValidFrom(index + 1));
+    }
+
+    constexpr bool reaches(size_t from, size_t target, size_t steps);
+
+    constexpr bool someEventReaches(size_t from, size_t event, size_t target, size_t steps) {
+        return event < ORDER_EVENT_COUNT &&
+               ((cell(from, event).moves() && reaches(cell(from, event).next, target, steps - 1)) ||
+                someEventReaches(from, event + 1, target, steps));
+    }
+
+    // target can be reached from "from" in at most steps moves
+    constexpr bool reaches(size_t from, size_t target, size_t steps) {
+        return from == target || (steps > 0 && someEventReaches(from, 0, target, steps));
+    }
+}
+
+static_assert(cellsValidFrom(0), "Order lifecycle table has an invalid transition");
+static_assert(reaches(ORDERING, COMPLETED, ORDER_STATUS_COUNT), "Orders must be able to complete");
+static_assert(reaches(ORDERING, CANCELLED, ORDER_STATUS_COUNT), "Orders must be able to be cancelled");
+static_assert(OrderLifecycle::next(ORDERING, CONFIRM_ORDER) == CONFIRMED &&
+              OrderLifecycle::next(CONFIRMED, PAY_ORDER) == PAID &&
+              OrderLifecycle::next(PAID, PREPARE_ORDER) == PREPARING &&
+              OrderLifecycle::next(PREPARING, DELIVER_ORDER) == DELIVERING &&
+              OrderLifecycle::next(DELIVERING, COMPLETE_ORDER) == COMPLETED,
+              "Order lifecycle must follow Ordering -> Confirmed -> Paid -> Preparing -> Delivering -> Completed");
+
+// ==================== Dispatch ====================
+
+OrderState& OrderLifecycle::stateFor(OrderStatus status) {
+    switch (status) {
+        case ORDERING: return OrderingState::instance();
+        case CONFIRMED: return ConfirmedState::instance();
+        case PAID: return PaidState::instance();
+        case PREPARING: return PreparingState::instance();
+        case DELIVERING: return DeliveringState::instance();
+        case COMPLETED: return CompletedState::instance();
+        case CANCELLED: return CancelledState::instance();
+    }
+    return CancelledState::instance();
+}
+
+bool OrderLifecycle::dispatch(PizzaOrders& order, OrderEvent event, int index, std::ostream& out) {
+    const OrderState* state = order.getCurrentState();
+    if (state == nullptr || event >= ORDER_EVENT_COUNT) {
+        return false;
+    }
+    const OrderTransition& step = TABLE[state->getStatus()][event];
+
+    bool allowed = true;
+    switch (step.guard) {
+        case OrderTransition::ALWAYS:
+            break;
+        case OrderTransition::HAS_PIZZAS:
+            allowed = order.getPizzaCount() > 0;
+            break;
+        case OrderTransition::VALID_INDEX:
+            allowed = index >= 0 && index < order.getPizzaCount();
+            break;
+    }
+    if (!allowed) {
+        out << step.refusal << '\n';
+        return false;
+    }
+
+    switch (step.action) {
+        case OrderTransition::REJECT:
+            out << "Cannot " << EVENT_NAMES[event] << " - " << step.text << '\n';
+            return false;
+        case OrderTransition::NOTE:
+            out << step.text << '\n';
+            return false;
+        case OrderTransition::REMOVE:
+            order.removePizza(index);
+            out << step.text << '\n';
+            return false;
+        case OrderTransition::MOVE:
+            out << step.text << '\n';
+            break;
+        case OrderTransition::MOVE_WITH_TOTAL:
+            out << step.text << order.getDiscountedTotal() << step.suffix << '\n';
+            break;
+    }
+    order.setState(stateFor(step.next));
+    return true;
+}
+
+bool OrderLifecycle::dispatch(PizzaOrders& order, OrderEvent event, int index, OutputSink& sink) {
+    Document document(sink);
+    return dispatch(order, event, index, static_cast<std::ostream&>(document));
+}
+
+size_t OrderLifecycle::apply(OrderEvent event, PizzaOrders* const* orders, size_t count, OutputSink& sink) {
+    Document document(sink);
+    size_t moved = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (orders[i] != nullptr && dispatch(*orders[i], event, 0, static_cast<std::ostream&>(document))) {
+            ++moved;
+        }
+    }
+    return moved;
+}
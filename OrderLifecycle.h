@@ -0,0 +1,233 @@
+#ifndef ORDERLIFECYCLE_H
+#define ORDERLIFECYCLE_H
+
+#include "OutputSink.h"
+#include <cstdint>
+#include <cstddef>
+
+class PizzaOrders;
+class OrderState;
+
+// Where an order is in its lifecycle
+enum OrderStatus : uint8_t {
+    ORDERING = 0,
+    CONFIRMED = 1,
+    PAID = 2,
+    PREPARING = 3,
+    DELIVERING = 4,
+    COMPLETED = 5,
+    CANCELLED = 6
+};
+const size_t ORDER_STATUS_COUNT = 7;
+
+// Something a customer or the store does to an order (PizzaOrders::perform*)
+enum OrderEvent : uint8_t {
+    ADD_PIZZA = 0,
+    REMOVE_PIZZA = 1,
+    CONFIRM_ORDER = 2,
+    CANCEL_ORDER = 3,
+    PAY_ORDER = 4,
+    PREPARE_ORDER = 5,
+    DELIVER_ORDER = 6,
+    COMPLETE_ORDER = 7
+};
+const size_t ORDER_EVENT_COUNT = 8;
+
+// One cell of the lifecycle table: what an event does to an order in a
+// given status
+struct OrderTransition {
+    // Checked before the action runs; refusal is printed if it fails
+    enum Guard : uint8_t {
+        ALWAYS,
+        HAS_PIZZAS,     // The order is not empty
+        VALID_INDEX     // The event's index names a pizza in the order
+    };
+
+    enum Action : uint8_t {
+        REJECT,           // Print "Cannot <event> - <text>"
+        NOTE,             // Print text
+        REMOVE,           // Remove the indexed pizza and print text
+        MOVE,             // Print text and move to next
+        MOVE_WITH_TOTAL   // Print text, the discounted total and suffix, and move to next
+    };
+
+    OrderStatus next;     // Status afterwards (the same one unless the action moves)
+    Guard guard;
+    Action action;
+    const char* text;
+    const char* suffix;
+    const char* refusal;
+
+    constexpr bool moves() const {
+        return action == MOVE || action == MOVE_WITH_TOTAL;
+    }
+
+    static constexpr OrderTransition reject(OrderStatus at, const char* reason) {
+        return OrderTransition{at, ALWAYS, REJECT, reason, "", ""};
+    }
+    static constexpr OrderTransition note(OrderStatus at, const char* message) {
+        return OrderTransition{at, ALWAYS, NOTE, message, "", ""};
+    }
+    static constexpr OrderTransition move(OrderStatus to, const char* message) {
+        return OrderTransition{to, ALWAYS, MOVE, message, "", ""};
+    }
+    static constexpr OrderTransition moveWithTotal(OrderStatus to, const char* message, const char* after) {
+        return OrderTransition{to, ALWAYS, MOVE_WITH_TOTAL, message, after, ""};
+    }
+    static constexpr OrderTransition remove(OrderStatus at, const char* message, const char* invalidIndex) {
+        return OrderTransition{at, VALID_INDEX, REMOVE, message, "", invalidIndex};
+    }
+
+    // The same transition behind a guard
+    constexpr OrderTransition onlyIf(Guard check, const char* whenRefused) const {
+        return OrderTransition{next, check, action, text, suffix, whenRefused};
+    }
+};
+
+// Name, editability and available actions of a status
+struct OrderStatusInfo {
+    const char* name;
+    bool canModify;
+    const char* actions;
+};
+
+// The whole order lifecycle as one table with a row per status and a column
+// per event:
+//
+//   Ordering -> Confirmed -> Paid -> Preparing -> Delivering -> Completed
+//        \__________\__________\_________\____________\______-> Cancelled
+//
+// Dispatching an event is a lookup in the order's row, a guard check and an
+// action; there are no per-state methods. The table is checked at compile
+// time (OrderLifecycle.cpp): moves only go one step forward or to Cancelled,
+// Completed and Cancelled are final, only editable statuses accept pizzas,
+// and both final statuses can be reached from Ordering.
+class OrderLifecycle {
+public:
+    static constexpr OrderStatusInfo STATUSES[ORDER_STATUS_COUNT] = {
+        {"Ordering", true, "Add Pizza, Remove Pizza, Confirm Order, Cancel Order"},
+        {"Confirmed", false, "Pay Order, Cancel Order"},
+        {"Paid", false, "Prepare Order, Cancel Order (with refund)"},
+        {"Preparing", false, "Deliver Order"},
+        {"Delivering", false, "Complete Order"},
+        {"Completed", false, "Order is complete - no actions available"},
+        {"Cancelled", false, "Order is cancelled - no actions available"}
+    };
+
+    // How each event reads in "Cannot <event> - <reason>", indexed by OrderEvent
+    static constexpr const char* EVENT_NAMES[ORDER_EVENT_COUNT] = {
+        "add pizza", "remove pizza", "confirm order", "cancel order",
+        "pay order", "prepare order", "deliver order", "complete order"
+    };
+
+    static constexpr OrderTransition TABLE[ORDER_STATUS_COUNT][ORDER_EVENT_COUNT] = {
+        // Ordering
+        {
+            OrderTransition::note(ORDERING, "Pizza added to order in Ordering state"),
+            OrderTransition::remove(ORDERING, "Pizza removed from order in Ordering state", "Invalid pizza index - cannot remove"),
+            OrderTransition::move(CONFIRMED, "Order confirmed! Moving to Confirmed state.")
+                .onlyIf(OrderTransition::HAS_PIZZAS, "Cannot confirm empty order. Please add pizzas first."),
+            OrderTransition::move(CANCELLED, "Order cancelled from Ordering state."),
+            OrderTransition::reject(ORDERING, "Ordering - please confirm order first"),
+            OrderTransition::reject(ORDERING, "Ordering - please confirm and pay first"),
+            OrderTransition::reject(ORDERING, "Ordering - order not ready for delivery"),
+            OrderTransition::reject(ORDERING, "Ordering - order not ready for completion")
+        },
+        // Confirmed
+        {
+            OrderTransition::reject(CONFIRMED, "Confirmed - order is locked for modifications"),
+            OrderTransition::reject(CONFIRMED, "Confirmed - order is locked for modifications"),
+            OrderTransition::note(CONFIRMED, "Order is already confirmed."),
+            OrderTransition::move(CANCELLED, "Order cancelled from Confirmed state."),
+            OrderTransition::moveWithTotal(PAID, "Payment processed! Order total: R", "\nMoving to Paid state."),
+            OrderTransition::reject(CONFIRMED, "Confirmed - payment required first"),
+            OrderTransition::reject(CONFIRMED, "Confirmed - payment and preparation required first"),
+            OrderTransition::reject(CONFIRMED, "Confirmed - payment and preparation required first")
+        },
+        // Paid
+        {
+            OrderTransition::reject(PAID, "Paid - order is locked for modifications"),
+            OrderTransition::reject(PAID, "Paid - order is locked for modifications"),
+            OrderTransition::note(PAID, "Order is already confirmed and paid."),
+            OrderTransition::moveWithTotal(CANCELLED, "Order cancelled from Paid state. Refund processed: R", ""),
+            OrderTransition::note(PAID, "Order is already paid for."),
+            OrderTransition::move(PREPARING, "Starting pizza preparation...\nMoving to Preparing state."),
+            OrderTransition::reject(PAID, "Paid - preparation required first"),
+            OrderTransition::reject(PAID, "Paid - preparation and delivery required first")
+        },
+        // Preparing
+        {
+            OrderTransition::reject(PREPARING, "Preparing - order is being prepared"),
+            OrderTransition::reject(PREPARING, "Preparing - order is being prepared"),
+            OrderTransition::note(PREPARING, "Order is confirmed and being prepared."),
+            OrderTransition::move(CANCELLED, "Order cancelled during preparation. Partial refund processed."),
+            OrderTransition::note(PREPARING, "Order is already paid for and being prepared."),
+            OrderTransition::note(PREPARING, "Order is already being prepared."),
+            OrderTransition::move(DELIVERING, "Pizzas ready! Starting delivery...\nMoving to Delivering state."),
+            OrderTransition::reject(PREPARING, "Preparing - delivery required first")
+        },
+        // Delivering
+        {
+            OrderTransition::reject(DELIVERING, "Delivering - order is out for delivery"),
+            OrderTransition::reject(DELIVERING, "Delivering - order is out for delivery"),
+            OrderTransition::note(DELIVERING, "Order is confirmed and out for delivery."),
+            OrderTransition::move(CANCELLED, "Order cancelled during delivery. Driver returning to store."),
+            OrderTransition::note(DELIVERING, "Order is already paid for and being delivered."),
+            OrderTransition::note(DELIVERING, "Order is already prepared and being delivered."),
+            OrderTransition::note(DELIVERING, "Order is already out for delivery."),
+            OrderTransition::move(COMPLETED, "Order delivered successfully!\nMoving to Completed state.")
+        },
+        // Completed
+        {
+            OrderTransition::reject(COMPLETED, "Completed - order is finished"),
+            OrderTransition::reject(COMPLETED, "Completed - order is finished"),
+            OrderTransition::note(COMPLETED, "Order is already completed."),
+            OrderTransition::reject(COMPLETED, "Completed - order is already finished"),
+            OrderTransition::note(COMPLETED, "Order was already paid for and completed."),
+            OrderTransition::note(COMPLETED, "Order was already prepared and completed."),
+            OrderTransition::note(COMPLETED, "Order was already delivered and completed."),
+            OrderTransition::note(COMPLETED, "Order is already completed.")
+        },
+        // Cancelled
+        {
+            OrderTransition::reject(CANCELLED, "Cancelled - order was cancelled"),
+            OrderTransition::reject(CANCELLED, "Cancelled - order was cancelled"),
+            OrderTransition::reject(CANCELLED, "Cancelled - order was cancelled"),
+            OrderTransition::note(CANCELLED, "Order is already cancelled."),
+            OrderTransition::reject(CANCELLED, "Cancelled - order was cancelled"),
+            OrderTransition::reject(CANCELLED, "Cancelled - order was cancelled"),
+            OrderTransition::reject(CANCELLED, "Cancelled - order was cancelled"),
+            OrderTransition::reject(CANCELLED, "Cancelled - order was cancelled")
+        }
+    };
+
+    static constexpr const OrderTransition& transition(OrderStatus status, OrderEvent event) {
+        return TABLE[status][event];
+    }
+
+    // Status an event leads to (the same status if it doesn't move the order)
+    static constexpr OrderStatus next(OrderStatus status, OrderEvent event) {
+        return TABLE[status][event].moves() ? TABLE[status][event].next : status;
+    }
+
+    // The shared state object for a status
+    static OrderState& stateFor(OrderStatus status);
+
+    // Run an event on an order (index is the pizza for REMOVE_PIZZA) and
+    // write what happened to sink as one document. Returns true if the order
+    // changed status. Orders without a state ignore events.
+    static bool dispatch(PizzaOrders& order, OrderEvent event, int index = 0,
+                         OutputSink& sink = OutputSink::console());
+
+    // The same, appending the message to a stream the caller already has
+    // open (such as a Document), so a run of events is written and flushed
+    // once instead of once per event
+    static bool dispatch(PizzaOrders& order, OrderEvent event, int index, std::ostream& out);
+
+    // Run one event on many orders, with their messages as one document.
+    // Null entries are skipped. Returns the number of orders that changed status.
+    static size_t apply(OrderEvent event, PizzaOrders* const* orders, size_t count,
+                        OutputSink& sink = OutputSink::console());
+};
+
+#endif // ORDERLIFECYCLE_H
@@ -0,0 +1,137 @@
+#include "OrderPool.h"
+#include <algorithm>
+
+// ==================== PooledOrder ====================
+
+PooledOrder::PooledOrder() : order(nullptr), pool(nullptr) {
+}
+
+PooledOrder::PooledOrder(PizzaOrders* pooledOrder, OrderPool* owner) : order(pooledOrder), pool(owner) {
+}
+
+PooledOrder::~PooledOrder() {
+    reset();
+}
+
+PooledOrder::PooledOrder(PooledOrder&& other) noexcept : order(other.order), pool(other.pool) {
+    other.order = nullptr;
+    other.pool = nullptr;
+}
+
+PooledOrder& PooledOrder::operator=(PooledOrder&& other) noexcept {
+    if (this != &other) {
+        reset();
+        order = other.order;
+        pool = other.pool;
+        other.order = nullptr;
+        other.pool = nullptr;
+    }
+    return *this;
+}
+
+void PooledOrder::reset() {
+    if (order != nullptr) {
+        pool->release(order);
+        order = nullptr;
+        pool = nullptr;
+    }
+}
+
+// ==================== OrderPool ====================
+
+double OrderPool::Stats::hitRate() const {
+    size_t acquires = hits + misses;
+    return acquires == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(acquires);
+}
+
+OrderPool::OrderPool(size_t maxRetainedBytes) : retainedLimit(maxRetainedBytes), retainedBytes(0) {
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.returned = 0;
+    stats.discarded = 0;
+}
+
+OrderPool::~OrderPool() {
+    clear();
+}
+
+OrderPool& OrderPool::local() {
+    static thread_local OrderPool pool;
+    return pool;
+}
+
+size_t OrderPool::footprint(const PizzaOrders& order) {
+    return sizeof(PizzaOrders) + order.getRetainedBytes();
+}
+
+PooledOrder OrderPool::acquire(int orderNumber, const std::string& customerName) {
+    PizzaOrders* order;
+    if (!idle.empty()) {
+        order = idle.back();
+        idle.pop_back();
+        retainedBytes -= footprint(*order);
+        ++stats.hits;
+
+        // Emptied on release; only the details and the catalog are new
+        order->reopen(orderNumber, customerName);
+    } else {
+        order = new PizzaOrders(orderNumber, customerName);
+        ++stats.misses;
+    }
+    return PooledOrder(order, this);
+}
+
+void OrderPool::release(PizzaOrders* order) {
+    if (order == nullptr) {
+        return;
+    }
+    order->recycle();
+    size_t bytes = footprint(*order);
+    size_t listCapacity = idle.size() < idle.capacity() ? idle.capacity() : std::max<size_t>(4, idle.capacity() * 2);
+    if (retainedBytes + bytes + listCapacity * sizeof(PizzaOrders*) > retainedLimit) {
+        delete order;
+        ++stats.discarded;
+        return;
+    }
+    idle.reserve(listCapacity);
+    idle.push_back(order);
+    retainedBytes += bytes;
+    ++stats.returned;
+}
+
+void OrderPool::trimTo(size_t limit) {
+    while (getRetainedBytes() > limit && !idle.empty()) {
+        PizzaOrders* order = idle.back();
+        idle.pop_back();
+        retainedBytes -= footprint(*order);
+        delete order;
+    }
+    if (idle.empty()) {
+        std::vector<PizzaOrders*>().swap(idle);
+    }
+}
+
+void OrderPool::setRetainedLimit(size_t bytes) {
+    retainedLimit = bytes;
+    trimTo(retainedLimit);
+}
+
+size_t OrderPool::getRetainedLimit() const {
+    return retainedLimit;
+}
+
+size_t OrderPool::getRetainedBytes() const {
+    return retainedBytes + idle.capacity() * sizeof(PizzaOrders*);
+}
+
+size_t OrderPool::getIdleCount() const {
+    return idle.size();
+}
+
+OrderPool::Stats OrderPool::getStats() const {
+    return stats;
+}
+
+void OrderPool::clear() {
+    trimTo(0);
+}
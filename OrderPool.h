@@ -0,0 +1,110 @@
+#ifndef ORDERPOOL_H
+#define ORDERPOOL_H
+
+#include "PizzaOrders.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+class OrderPool;
+
+// Move-only lease of a pooled order. The order goes back to its pool when
+// the lease is destroyed or reset.
+class PooledOrder {
+private:
+    PizzaOrders* order;
+    OrderPool* pool;
+
+public:
+    PooledOrder();
+    PooledOrder(PizzaOrders* pooledOrder, OrderPool* owner);
+    ~PooledOrder();
+
+    PooledOrder(PooledOrder&& other) noexcept;
+    PooledOrder& operator=(PooledOrder&& other) noexcept;
+    PooledOrder(const PooledOrder&) = delete;
+    PooledOrder& operator=(const PooledOrder&) = delete;
+
+    PizzaOrders* get() const { return order; }
+    PizzaOrders* operator->() const { return order; }
+    PizzaOrders& operator*() const { return *order; }
+    explicit operator bool() const { return order != nullptr; }
+
+    // Return the order to the pool now
+    void reset();
+};
+
+// Recycles PizzaOrders objects so a busy till doesn't allocate an order, its
+// pizza list and its arena for every customer. Released orders are reset
+// (pizzas, discount and state cleared) but keep their list capacity and
+// largest arena chunk, up to a cap on the memory the pool retains:
+//
+//   PooledOrder order = OrderPool::local().acquire(1042, "Walk-in");
+//   order->addPizza(order->createPepperoniPizza());
+//   ...                                  // back to the pool when it goes
+//
+// Each thread has its own pool (local()), so acquiring and releasing take
+// no locks. A lease must be released on the thread that acquired it, before
+// that thread exits.
+class OrderPool {
+public:
+    struct Stats {
+        size_t hits;        // Acquires served from the pool
+        size_t misses;      // Acquires that had to create an order
+        size_t returned;    // Orders kept for reuse on release
+        size_t discarded;   // Orders deleted on release (pool over its cap)
+
+        // Share of acquires served from the pool (0 before the first acquire)
+        double hitRate() const;
+    };
+
+    // Memory a pool retains unless told otherwise
+    static const size_t DEFAULT_RETAINED_LIMIT = 4 * 1024 * 1024;
+
+private:
+    std::vector<PizzaOrders*> idle;
+    size_t retainedLimit;
+    size_t retainedBytes;   // Idle orders only (getRetainedBytes() adds the list)
+    Stats stats;
+
+    // Memory an idle order accounts for in the pool
+    static size_t footprint(const PizzaOrders& order);
+
+    // Delete idle orders until the pool fits in limit bytes
+    void trimTo(size_t limit);
+
+    OrderPool(const OrderPool&) = delete;
+    OrderPool& operator=(const OrderPool&) = delete;
+
+public:
+    explicit OrderPool(size_t maxRetainedBytes = DEFAULT_RETAINED_LIMIT);
+    ~OrderPool();
+
+    // This thread's pool
+    static OrderPool& local();
+
+    // An empty order in the Ordering state, reused if the pool has one
+    PooledOrder acquire(int orderNumber, const std::string& customerName);
+
+    // Take an order back (called by PooledOrder). The order is emptied and
+    // lets go of its catalog snapshot, so idle orders never keep a retired
+    // snapshot alive, then kept if it fits under the cap and deleted
+    // otherwise. acquire() pins the latest catalog when it goes out again.
+    void release(PizzaOrders* order);
+
+    // Change the cap, deleting idle orders that no longer fit
+    void setRetainedLimit(size_t bytes);
+    size_t getRetainedLimit() const;
+
+    // Memory held by idle orders (including the order objects) and by the
+    // idle list itself; this is what the cap bounds
+    size_t getRetainedBytes() const;
+    size_t getIdleCount() const;
+
+    Stats getStats() const;
+
+    // Delete every idle order (the counters are kept)
+    void clear();
+};
+
+#endif
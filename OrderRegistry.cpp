@@ -0,0 +1,116 @@
+#include "OrderRegistry.h"
+
+namespace {
+    std::atomic<uint64_t> registriesCreated(0);
+
+    // This thread's current block of order numbers
+    struct NumberBlock {
+        uint64_t registryId;
+        int next;
+        int end;
+    };
+    thread_local NumberBlock numberBlock = {0, 0, 0};
+}
+
+// ==================== RegisteredOrder ====================
+
+bool RegisteredOrder::dispatch(OrderEvent event, int index, OutputSink& sink) const {
+    std::lock_guard<std::mutex> guard(entry->lock);
+    return OrderLifecycle::dispatch(entry->order, event, index, sink);
+}
+
+// ==================== OrderRegistry ====================
+
+OrderRegistry::OrderRegistry(size_t shardCount, int firstOrderNumber)
+    : shardMask(0), nextBlock(firstOrderNumber), registryId(++registriesCreated) {
+    size_t count = 1;
+    while (count < shardCount) {
+        count <<= 1;
+    }
+    shards.reset(new Shard[count]);
+    shardMask = count - 1;
+}
+
+OrderRegistry::Shard& OrderRegistry::shardFor(int orderNumber) const {
+    // Consecutive numbers land in consecutive shards
+    return shards[static_cast<size_t>(static_cast<unsigned>(orderNumber)) & shardMask];
+}
+
+int OrderRegistry::allocateNumber() {
+    NumberBlock& block = numberBlock;
+    if (block.registryId != registryId || block.next == block.end) {
+        block.registryId = registryId;
+        block.next = nextBlock.fetch_add(NUMBER_BLOCK, std::memory_order_relaxed);
+        block.end = block.next + NUMBER_BLOCK;
+    }
+    return block.next++;
+}
+
+RegisteredOrder OrderRegistry::create(const std::string& customerName) {
+    int orderNumber = allocateNumber();
+    std::shared_ptr<RegistryEntry> entry = std::make_shared<RegistryEntry>(orderNumber, customerName);
+
+    Shard& shard = shardFor(orderNumber);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.orders.emplace(orderNumber, entry);
+    return RegisteredOrder(std::move(entry));
+}
+
+std::shared_ptr<RegistryEntry> OrderRegistry::lookup(int orderNumber) const {
+    Shard& shard = shardFor(orderNumber);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    auto found = shard.orders.find(orderNumber);
+    if (found == shard.orders.end()) {
+        return std::shared_ptr<RegistryEntry>();
+    }
+    return found->second;
+}
+
+RegisteredOrder OrderRegistry::find(int orderNumber) const {
+    return RegisteredOrder(lookup(orderNumber));
+}
+
+bool OrderRegistry::contains(int orderNumber) const {
+    Shard& shard = shardFor(orderNumber);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.orders.count(orderNumber) != 0;
+}
+
+bool OrderRegistry::transition(int orderNumber, OrderEvent event, int index, OutputSink& sink) {
+    std::shared_ptr<RegistryEntry> entry = lookup(orderNumber);
+    if (!entry) {
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(entry->lock);
+    return OrderLifecycle::dispatch(entry->order, event, index, sink);
+}
+
+bool OrderRegistry::retire(int orderNumber) {
+    std::shared_ptr<RegistryEntry> entry;
+    {
+        Shard& shard = shardFor(orderNumber);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto found = shard.orders.find(orderNumber);
+        if (found == shard.orders.end()) {
+            return false;
+        }
+        entry = std::move(found->second);
+        shard.orders.erase(found);
+    }
+    // The order itself is destroyed here (outside the shard lock) unless a handle still holds it
+    entry->retired.store(true, std::memory_order_release);
+    return true;
+}
+
+size_t OrderRegistry::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i <= shardMask; ++i) {
+        std::lock_guard<std::mutex> guard(shards[i].lock);
+        total += shards[i].orders.size();
+    }
+    return total;
+}
+
+size_t OrderRegistry::getShardCount() const {
+    return shardMask + 1;
+}
@@ -0,0 +1,126 @@
+#ifndef ORDERREGISTRY_H
+#define ORDERREGISTRY_H
+
+#include "PizzaOrders.h"
+#include "OrderLifecycle.h"
+#include "OutputSink.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+// A live order in the registry, with the lock that serialises work on it
+struct RegistryEntry {
+    const int number;
+    std::mutex lock;
+    PizzaOrders order;
+    std::atomic<bool> retired;
+
+    RegistryEntry(int orderNumber, const std::string& customerName)
+        : number(orderNumber), order(orderNumber, customerName), retired(false) {}
+};
+
+// Stable handle to a registered order. It stays valid after the order is
+// retired (the order lives until the last handle goes), and every access
+// goes through the order's own lock, so handles can be shared between threads.
+class RegisteredOrder {
+private:
+    std::shared_ptr<RegistryEntry> entry;
+
+public:
+    RegisteredOrder() = default;
+    explicit RegisteredOrder(std::shared_ptr<RegistryEntry> registryEntry) : entry(std::move(registryEntry)) {}
+
+    explicit operator bool() const { return entry != nullptr; }
+
+    int getOrderNumber() const { return entry->number; }
+
+    // True once the registry has let go of the order
+    bool isRetired() const { return entry->retired.load(std::memory_order_acquire); }
+
+    // Run f(PizzaOrders&) with the order locked and return its result
+    template <typename Function>
+    auto withOrder(Function f) const -> decltype(f(std::declval<PizzaOrders&>())) {
+        std::lock_guard<std::mutex> guard(entry->lock);
+        return f(entry->order);
+    }
+
+    // Run a lifecycle event on the order (see OrderLifecycle::dispatch)
+    bool dispatch(OrderEvent event, int index = 0, OutputSink& sink = OutputSink::console()) const;
+};
+
+// Owns the live orders of a store and indexes them by order number, so any
+// thread can look an order up, move it along its lifecycle or retire it:
+//
+//   OrderRegistry registry;
+//   RegisteredOrder order = registry.create("Walk-in");
+//   order.withOrder([](PizzaOrders& o) { o.addPizza(o.createPepperoniPizza()); });
+//   registry.transition(order.getOrderNumber(), CONFIRM_ORDER);
+//   registry.retire(order.getOrderNumber());
+//
+// Orders are spread over a power-of-two number of shards by order number,
+// each a hash table behind its own mutex, so threads working on different
+// orders rarely meet. Shard locks are only held to find, insert or erase an
+// entry; work on an order holds that order's lock instead.
+//
+// Order numbers come from an atomic counter in blocks of NUMBER_BLOCK, so a
+// thread touches the shared counter once per block. Numbers are unique but
+// not dense: each thread hands out its own block in increasing order.
+class OrderRegistry {
+public:
+    static const size_t DEFAULT_SHARD_COUNT = 64;
+    static const int NUMBER_BLOCK = 64;
+
+private:
+    // One lock stripe. The padding keeps the locks of neighbouring shards
+    // off each other's cache lines.
+    struct Shard {
+        mutable std::mutex lock;
+        std::unordered_map<int, std::shared_ptr<RegistryEntry>> orders;
+        char padding[64];
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shardMask;
+    std::atomic<int> nextBlock;
+    const uint64_t registryId;   // Tells the per-thread number blocks of registries apart
+
+    Shard& shardFor(int orderNumber) const;
+
+    // Shared pointer to a registered order, or null
+    std::shared_ptr<RegistryEntry> lookup(int orderNumber) const;
+
+    int allocateNumber();
+
+    OrderRegistry(const OrderRegistry&) = delete;
+    OrderRegistry& operator=(const OrderRegistry&) = delete;
+
+public:
+    // shardCount is rounded up to a power of two
+    explicit OrderRegistry(size_t shardCount = DEFAULT_SHARD_COUNT, int firstOrderNumber = 1);
+
+    // A new empty order in the Ordering state, under a fresh order number
+    RegisteredOrder create(const std::string& customerName);
+
+    // Handle to a live order (empty if the number isn't registered)
+    RegisteredOrder find(int orderNumber) const;
+    bool contains(int orderNumber) const;
+
+    // Run a lifecycle event on a live order. Returns true if it changed
+    // status, false if it didn't or the order isn't registered.
+    bool transition(int orderNumber, OrderEvent event, int index = 0, OutputSink& sink = OutputSink::console());
+
+    // Remove an order from the registry. Handles still held keep it alive
+    // and see isRetired(). Returns false if it wasn't registered.
+    bool retire(int orderNumber);
+
+    // Number of live orders (a snapshot; other threads may be changing it)
+    size_t size() const;
+    size_t getShardCount() const;
+};
+
+#endif
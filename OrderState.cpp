@@ -1,6 +1,13 @@
 #include "OrderState.h"
-#include "PizzaOrders.h"
 
-void OrderState::changeState(PizzaOrders* context, OrderState* newState) {
-    context->setState(newState);
-}
\ No newline at end of file
+std::string OrderState::getStateName() const {
+    return OrderLifecycle::STATUSES[status].name;
+}
+
+bool OrderState::canModifyOrder() const {
+    return OrderLifecycle::STATUSES[status].canModify;
+}
+
+std::string OrderState::getAvailableActions() const {
+    return OrderLifecycle::STATUSES[status].actions;
+}
@@ -0,0 +1,108 @@
+#include "OutputSink.h"
+#include <iostream>
+#include <cerrno>
+#include <unistd.h>
+
+OutputSink& OutputSink::console() {
+    static ConsoleSink sink;
+    return sink;
+}
+
+// ==================== ConsoleSink ====================
+
+void ConsoleSink::write(const char* data, size_t length) {
+    std::cout.write(data, static_cast<std::streamsize>(length));
+}
+
+void ConsoleSink::flush() {
+    std::cout.flush();
+}
+
+// ==================== StringSink ====================
+
+void StringSink::write(const char* data, size_t length) {
+    text.append(data, length);
+}
+
+void StringSink::flush() {
+}
+
+// ==================== FileSink ====================
+
+FileSink::FileSink(const std::string& path, bool append) : file(std::fopen(path.c_str(), append ? "a" : "w")) {
+    if (file == nullptr) {
+        std::cerr << "Error: Could not open output file '" << path << "'." << std::endl;
+    }
+}
+
+FileSink::~FileSink() {
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+}
+
+void FileSink::write(const char* data, size_t length) {
+    if (file != nullptr) {
+        std::fwrite(data, 1, length, file);
+    }
+}
+
+void FileSink::flush() {
+    if (file != nullptr) {
+        std::fflush(file);
+    }
+}
+
+// ==================== FdSink ====================
+
+FdSink::FdSink(int descriptor) : fd(descriptor) {
+}
+
+FdSink::~FdSink() {
+    flush();
+}
+
+void FdSink::write(const char* data, size_t length) {
+    pending.append(data, length);
+}
+
+void FdSink::flush() {
+    size_t written = 0;
+    while (written < pending.size()) {
+        ssize_t result = ::write(fd, pending.data() + written, pending.size() - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Error: Could not write to file descriptor " << fd << "." << std::endl;
+            break;
+        }
+        written += static_cast<size_t>(result);
+    }
+    pending.clear();
+}
+
+// ==================== Document ====================
+
+Document::Buffer::int_type Document::Buffer::overflow(int_type character) {
+    if (!traits_type::eq_int_type(character, traits_type::eof())) {
+        text.push_back(traits_type::to_char_type(character));
+    }
+    return traits_type::not_eof(character);
+}
+
+std::streamsize Document::Buffer::xsputn(const char* data, std::streamsize length) {
+    text.append(data, static_cast<size_t>(length));
+    return length;
+}
+
+Document::Document(OutputSink& destination) : std::ostream(nullptr), sink(destination), buffer(text) {
+    rdbuf(&buffer);
+}
+
+Document::~Document() {
+    if (!text.empty()) {
+        sink.write(text.data(), text.size());
+    }
+    sink.flush();
+}
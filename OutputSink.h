@@ -0,0 +1,121 @@
+#ifndef OUTPUTSINK_H
+#define OUTPUTSINK_H
+
+#include <string>
+#include <ostream>
+#include <streambuf>
+#include <cstdio>
+#include <cstddef>
+
+// Destination for rendered text: receipts, menu boards, notifications.
+// Display methods take a sink (the console by default) and render each
+// document into memory first, so a sink sees one write and one flush per
+// document instead of a flush per line:
+//
+//   StringSink receipts;
+//   for (PizzaOrders* order : orders) {
+//       order->displayOrder(receipts);
+//   }
+class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+
+    // Append text (may be buffered until flush())
+    virtual void write(const char* data, size_t length) = 0;
+
+    // Push buffered text to the destination
+    virtual void flush() = 0;
+
+    // std::cout, the default for every display method
+    static OutputSink& console();
+};
+
+// Writes to std::cout, so it stays in order with other console output
+class ConsoleSink : public OutputSink {
+public:
+    void write(const char* data, size_t length) override;
+    void flush() override;
+};
+
+// Collects everything in a string (flush does nothing)
+class StringSink : public OutputSink {
+private:
+    std::string text;
+
+public:
+    void write(const char* data, size_t length) override;
+    void flush() override;
+
+    const std::string& str() const { return text; }
+    void clear() { text.clear(); }
+};
+
+// Appends to a file through stdio's buffer
+class FileSink : public OutputSink {
+private:
+    std::FILE* file;
+
+public:
+    // Open path for writing (truncated unless append is set). Check isOpen();
+    // writes to a sink that failed to open are dropped.
+    explicit FileSink(const std::string& path, bool append = false);
+    ~FileSink();
+
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+
+    void write(const char* data, size_t length) override;
+    void flush() override;
+};
+
+// Buffers text for a file descriptor (socket, pipe, terminal) and hands it
+// over with write(2) on flush. The descriptor is not closed.
+class FdSink : public OutputSink {
+private:
+    int fd;
+    std::string pending;
+
+public:
+    explicit FdSink(int descriptor);
+    ~FdSink();
+
+    FdSink(const FdSink&) = delete;
+    FdSink& operator=(const FdSink&) = delete;
+
+    void write(const char* data, size_t length) override;
+    void flush() override;
+};
+
+// One document being rendered. It is a std::ostream, so everything that
+// streams (Money, nameOf()) works unchanged; the text goes to the sink in
+// one write, followed by one flush, when the document is destroyed.
+class Document : public std::ostream {
+private:
+    // Appends to the document's text
+    class Buffer : public std::streambuf {
+    private:
+        std::string& text;
+
+    protected:
+        int_type overflow(int_type character) override;
+        std::streamsize xsputn(const char* data, std::streamsize length) override;
+
+    public:
+        explicit Buffer(std::string& target) : text(target) {}
+    };
+
+    OutputSink& sink;
+    std::string text;
+    Buffer buffer;
+
+public:
+    explicit Document(OutputSink& destination);
+    ~Document();
+
+    Document(const Document&) = delete;
+    Document& operator=(const Document&) = delete;
+};
+
+#endif
@@ -1,6 +1,24 @@
 #include "Pizza.h"
-#include <iostream>
+#include "PizzaName.h"
 
-void Pizza::printPizza() {
-    std::cout << getName() << " - R" << getPrice() << std::endl;
+void Pizza::printPizza(OutputSink& sink) {
+    Document document(sink);
+    renderPizza(document);
+}
+
+void Pizza::renderPizza(std::ostream& out) {
+    out << nameOf(*this) << " - R" << getPrice() << '\n';
+}
+
+Pizza* Pizza::clone() const {
+    return cloneInto(MemoryResource::heap());
+}
+
+void Pizza::writeName(NameWriter& out) {
+    out.append(getName());
+}
+
+PizzaFingerprint Pizza::getFingerprint() {
+    std::string rendered = renderName(*this);
+    return PizzaFingerprint::ofTopping(rendered.data(), rendered.size());
 }
\ No newline at end of file
@@ -1,16 +1,46 @@
 #ifndef PIZZA_H
 #define PIZZA_H
 
+#include "Money.h"
+#include "MemoryResource.h"
+#include "PizzaFingerprint.h"
+#include "OutputSink.h"
 #include <string>
 
+class NameWriter;
+class PizzaDecorator;
+
 // Abstract base class for all pizzas
-class Pizza {
+class Pizza : public ResourceAllocated {
 public:
     virtual ~Pizza() = default;
-    virtual double getPrice() = 0;
+    virtual Money getPrice() = 0;
     virtual std::string getName() = 0;
-    virtual void printPizza();
-    virtual Pizza* clone() const = 0;
+    
+    // Write the full name to a NameWriter in one pass (see PizzaName.h).
+    // The default writes getName().
+    virtual void writeName(NameWriter& out);
+    
+    // Print the pizza as one document (to the console unless a sink is given)
+    void printPizza(OutputSink& sink = OutputSink::console());
+    
+    // Text printPizza() prints; the default is "Name - Rprice"
+    virtual void renderPizza(std::ostream& out);
+    
+    // Canonical product identity: toppings and modifiers, independent of how
+    // the pizza was built (see PizzaFingerprint.h). The default treats the
+    // rendered name as a single topping.
+    virtual PizzaFingerprint getFingerprint();
+    
+    // Deep copy on the heap
+    Pizza* clone() const;
+    
+    // Deep copy with every node allocated from the given resource
+    virtual Pizza* cloneInto(MemoryResource& resource) const = 0;
+    
+    // The modifier set if this pizza is decorated, so callers can reach the
+    // add-ons without RTTI (nullptr for an undecorated pizza)
+    virtual PizzaDecorator* asDecorator() { return nullptr; }
 };
 
 #endif
\ No newline at end of file
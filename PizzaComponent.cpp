@@ -1,6 +1,20 @@
 #include "PizzaComponent.h"
+#include "PizzaName.h"
 
-PizzaComponent::PizzaComponent(double price, const std::string& name)
+PizzaComponent::PizzaComponent(Money price, const std::string& name)
     : price(price), name(name) {
 }
 
+
+PizzaComponent* PizzaComponent::clone() const {
+    return cloneInto(MemoryResource::heap());
+}
+
+void PizzaComponent::writeName(NameWriter& out) const {
+    out.append(getName());
+}
+
+PizzaFingerprint PizzaComponent::getFingerprint() const {
+    std::string rendered = getName();
+    return PizzaFingerprint::ofTopping(rendered.data(), rendered.size());
+}
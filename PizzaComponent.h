@@ -1,23 +1,53 @@
 #ifndef PIZZACOMPONENT_H
 #define PIZZACOMPONENT_H
 
+#include "Money.h"
+#include "MemoryResource.h"
+#include "PizzaFingerprint.h"
 #include <string>
 
-class PizzaComponent {
+class NameWriter;
+
+class PizzaComponent : public ResourceAllocated {
 protected:
-    double price;
+    Money price;
     std::string name;
 
 public:
     // Constructor
-    PizzaComponent(double price = 0.0, const std::string& name = "");
+    PizzaComponent(Money price = Money(), const std::string& name = "");
     
     // Virtual destructor
     virtual ~PizzaComponent() = default;
     
     // Pure virtual methods
     virtual std::string getName() const = 0;
-    virtual double getPrice() const = 0;
+    virtual Money getPrice() const = 0;
+    
+    // Write the name to a NameWriter without building intermediate strings
+    // (the default writes getName())
+    virtual void writeName(NameWriter& out) const;
+    
+    // Canonical product identity of the subtree (see PizzaFingerprint.h).
+    // The default treats the rendered name as a single topping.
+    virtual PizzaFingerprint getFingerprint() const;
+    
+    // Shared components are owned elsewhere (e.g. interned toppings owned by
+    // the catalog) and must not be copied or deleted by a parent group
+    virtual bool isShared() const { return false; }
+    
+    // Concrete component type, so callers can dispatch without RTTI
+    enum Kind {
+        TOPPING,
+        GROUP
+    };
+    virtual Kind getKind() const = 0;
+    
+    // Copy allocated from resource; the copy is never shared
+    virtual PizzaComponent* cloneInto(MemoryResource& resource) const = 0;
+    
+    // Copy allocated on the heap
+    PizzaComponent* clone() const;
 };
 
 #endif
\ No newline at end of file
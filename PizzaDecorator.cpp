@@ -1,49 +1,139 @@
 #include "PizzaDecorator.h"
 #include "BasePizza.h"
+#include "PizzaName.h"
+#include <utility>
+#include <cstring>
 
 PizzaDecorator::PizzaDecorator(Pizza* pizzaToDecorate) 
-    : pizza(pizzaToDecorate) {
+    : owned(pizzaToDecorate), pizza(pizzaToDecorate), modifierCount(0) {
+}
+
+PizzaDecorator::PizzaDecorator(Pizza* pizzaToDecorate, PizzaModifier modifier)
+    : owned(pizzaToDecorate), pizza(pizzaToDecorate), modifierCount(0) {
+    foldWrapped();
+    addModifier(modifier);
 }
 
 PizzaDecorator::~PizzaDecorator() {
-    delete pizza;  // Always delete the wrapped pizza
+    delete owned;  // Always delete the pizza we were given
 }
 
-PizzaDecorator::PizzaDecorator(const PizzaDecorator& other) {
-    if (other.pizza != nullptr) {
-        this->pizza = other.pizza->clone(); // Use clone method for proper deep copy
-    } else {
-        this->pizza = nullptr;
+PizzaDecorator::PizzaDecorator(const PizzaDecorator& other)
+    : Pizza(other), owned(other.owned != nullptr ? other.owned->clone() : nullptr), pizza(owned), modifierCount(0) {
+    copyModifiers(other);
+}
+
+PizzaDecorator::PizzaDecorator(PizzaDecorator&& other) noexcept
+    : Pizza(std::move(other)), owned(other.owned), pizza(other.pizza), modifierCount(other.modifierCount) {
+    other.owned = nullptr;
+    other.pizza = nullptr;
+    for (size_t i = 0; i < modifierCount; ++i) {
+        modifiers[i] = other.modifiers[i];
     }
 }
 
 PizzaDecorator& PizzaDecorator::operator=(const PizzaDecorator& other) {
     if (this != &other) {
-        delete pizza;  // Clean up existing pizza
-        
-        if (other.pizza != nullptr) {
-            this->pizza = other.pizza->clone(); // Use clone method
-        } else {
-            this->pizza = nullptr;
-        }
+        delete owned;  // Clean up existing pizza
+        owned = other.owned != nullptr ? other.owned->clone() : nullptr;
+        copyModifiers(other);
     }
     return *this;
 }
 
-double PizzaDecorator::getPrice() {
+void PizzaDecorator::foldWrapped() {
+    PizzaDecorator* inner = owned != nullptr ? owned->asDecorator() : nullptr;
+    if (inner != nullptr && inner->modifierCount < MAX_MODIFIERS) {
+        pizza = inner->pizza;
+        modifierCount = inner->modifierCount;
+        for (size_t i = 0; i < modifierCount; ++i) {
+            modifiers[i] = inner->modifiers[i];
+        }
+    }
+}
+
+Money PizzaDecorator::getPrice() {
+    CatalogScope scope;
+    const ToppingCatalog& catalog = scope.catalog();
+    
+    Money price = pizza != nullptr ? pizza->getPrice() : Money();
+    for (size_t i = 0; i < modifierCount; ++i) {
+        price += catalog.getModifierPrice(static_cast<PizzaModifier>(modifiers[i]));
+    }
+    return price;
+}
+
+PizzaFingerprint PizzaDecorator::getFingerprint() {
+    // A sum, so the order the modifiers were applied in doesn't matter
+    PizzaFingerprint fingerprint = pizza != nullptr ? pizza->getFingerprint() : PizzaFingerprint();
+    for (size_t i = 0; i < modifierCount; ++i) {
+        fingerprint += PizzaFingerprint::ofModifier(static_cast<PizzaModifier>(modifiers[i]));
+    }
+    return fingerprint;
+}
+
+std::string PizzaDecorator::getName() {
+    return renderName(*this);
+}
+
+void PizzaDecorator::writeName(NameWriter& out) {
     if (pizza != nullptr) {
-        return pizza->getPrice();
+        pizza->writeName(out);
+    } else {
+        out.append("Unknown Pizza");
+    }
+    for (size_t i = 0; i < modifierCount; ++i) {
+        const char* modifierName = ToppingCatalog::getModifierName(static_cast<PizzaModifier>(modifiers[i]));
+        out.append(" + ");
+        out.append(modifierName, std::strlen(modifierName));
+    }
+}
+
+void PizzaDecorator::renderPizza(std::ostream& out) {
+    if (modifierCount == 0) {
+        Pizza::renderPizza(out);
+        return;
+    }
+    // Labelled by the outermost add-on, as the separate wrappers used to be
+    out << "Pizza with " << ToppingCatalog::getModifierName(getModifier(modifierCount - 1))
+        << ": " << nameOf(*this) << '\n';
+    out << "Price: R" << getPrice() << '\n';
+}
+
+bool PizzaDecorator::addModifier(PizzaModifier modifier) {
+    if (modifierCount == MAX_MODIFIERS || modifier >= PIZZA_MODIFIER_COUNT) {
+        return false;
     }
-    return 0.0;
+    modifiers[modifierCount++] = modifier;
+    return true;
+}
+
+size_t PizzaDecorator::getModifierCount() const {
+    return modifierCount;
+}
+
+PizzaModifier PizzaDecorator::getModifier(size_t index) const {
+    return static_cast<PizzaModifier>(modifiers[index]);
 }
 
 Pizza* PizzaDecorator::getWrappedPizza() const {
     return pizza;
 }
 
-std::string PizzaDecorator::getName() {
-    if (pizza != nullptr) {
-        return pizza->getName();
+void PizzaDecorator::copyModifiers(const PizzaDecorator& other) {
+    // Apply the modifiers at the same depth as other does
+    pizza = owned;
+    if (other.pizza != other.owned && owned != nullptr && owned->asDecorator() != nullptr) {
+        pizza = owned->asDecorator()->pizza;
+    }
+    modifierCount = other.modifierCount;
+    for (size_t i = 0; i < modifierCount; ++i) {
+        modifiers[i] = other.modifiers[i];
     }
-    return "Unknown Pizza";
+}
+
+Pizza* PizzaDecorator::cloneInto(MemoryResource& resource) const {
+    PizzaDecorator* copy = new (resource) PizzaDecorator(owned != nullptr ? owned->cloneInto(resource) : nullptr);
+    copy->copyModifiers(*this);
+    return copy;
 }
@@ -2,28 +2,85 @@
 #define PIZZADECORATOR_H
 
 #include "Pizza.h"
+#include "ToppingCatalog.h"
 #include <string>
+#include <cstdint>
 
-// Abstract decorator class that wraps a Pizza
+// Add-ons (extra cheese, stuffed crust, ...) around a pizza. Instead of one
+// wrapper object per add-on, every modifier applied to a pizza is kept in a
+// small inline set on a single decorator, so pricing is one virtual call to
+// the pizza plus a linear pass over the modifiers, and a clone allocates one
+// decorator however many add-ons there are.
+//
+// The decorator-style constructors (ExtraCheese, StuffedCrust) keep the
+// usual ownership: the new decorator owns the pizza it was given, and the
+// caller's pointer to it stays valid. When that pizza is itself a decorator
+// with room to spare, its modifiers are folded into the new decorator's set
+// and the new decorator applies them straight to the inner decorator's
+// pizza, so
+//
+//   new StuffedCrust(new ExtraCheese(pizza))
+//
+// prices as one pass over {Extra Cheese, Stuffed Crust}. Modifiers added to
+// the inner decorator after it has been wrapped are not seen by the outer one.
 class PizzaDecorator : public Pizza {
+public:
+    // Modifiers held inline by one decorator
+    static const size_t MAX_MODIFIERS = 7;
+
 protected:
+    // Pizza this decorator was given and owns (may itself be a decorator)
+    Pizza* owned;
+    
+    // Pizza the modifiers are applied to: owned, or the pizza inside it when
+    // owned's modifiers were folded into this set
     Pizza* pizza;
+    
+    uint8_t modifiers[MAX_MODIFIERS];  // PizzaModifier values, innermost first
+    uint8_t modifierCount;
+
+    // Decorate pizzaToDecorate with one modifier (used by ExtraCheese and StuffedCrust)
+    PizzaDecorator(Pizza* pizzaToDecorate, PizzaModifier modifier);
+
+    // Take other's modifier set, folded the same way (used when cloning;
+    // owned must be a copy of other's)
+    void copyModifiers(const PizzaDecorator& other);
+
+private:
+    // Fold owned's modifiers into this set if there is room for one more
+    void foldWrapped();
 
 public:
-    PizzaDecorator(Pizza* pizzaToDecorate);
+    // Decorator with no modifiers yet (add them with addModifier). A
+    // decorator given here is wrapped as it is, not folded.
+    explicit PizzaDecorator(Pizza* pizzaToDecorate);
     virtual ~PizzaDecorator();
     
     // Copy constructor and assignment operator
     PizzaDecorator(const PizzaDecorator& other);
     PizzaDecorator& operator=(const PizzaDecorator& other);
     
-    virtual double getPrice() override;
+    // Moving takes over the wrapped pizza
+    PizzaDecorator(PizzaDecorator&& other) noexcept;
+    
+    virtual Money getPrice() override;
+    virtual PizzaFingerprint getFingerprint() override;
     virtual std::string getName() override;
+    virtual void writeName(NameWriter& out) override;
+    virtual void renderPizza(std::ostream& out) override;
+    
+    // Apply another modifier (outermost). Returns false if the set is full.
+    bool addModifier(PizzaModifier modifier);
+    
+    // Modifiers in the order they were applied
+    size_t getModifierCount() const;
+    PizzaModifier getModifier(size_t index) const;
     
-    // Getter for the wrapped pizza
+    // Pizza the modifier set applies to (below any folded decorators)
     Pizza* getWrappedPizza() const;
 
-    virtual Pizza* clone() const override = 0;
+    virtual Pizza* cloneInto(MemoryResource& resource) const override;
+    virtual PizzaDecorator* asDecorator() override { return this; }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,18 @@
+#include "PizzaFingerprint.h"
+
+PizzaFingerprint PizzaFingerprint::ofTopping(ToppingId id, unsigned quantity) {
+    CatalogScope scope;
+    size_t length = 0;
+    const char* name = scope.catalog().getNameData(id, length);
+    return name != nullptr ? ofTopping(name, length, quantity) : PizzaFingerprint();
+}
+
+std::string PizzaFingerprint::toString() const {
+    static const char digits[] = "0123456789abcdef";
+    std::string text(32, '0');
+    for (int i = 0; i < 16; ++i) {
+        text[15 - i] = digits[(high >> (4 * i)) & 0xf];
+        text[31 - i] = digits[(low >> (4 * i)) & 0xf];
+    }
+    return text;
+}
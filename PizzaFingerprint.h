@@ -0,0 +1,108 @@
+#ifndef PIZZAFINGERPRINT_H
+#define PIZZAFINGERPRINT_H
+
+#include "ToppingCatalog.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <functional>
+
+// Canonical 128-bit identity of a pizza as a product: which toppings it has
+// (with portions) and which modifiers. Group names and nesting, the order the
+// toppings were added in and the order of the decorators don't change it, so
+// createPepperoniPizza(true) and a custom "Base + Pepperoni" pizza with extra
+// cheese get the same fingerprint.
+//
+// A fingerprint is a sum: every portion of a topping and every modifier adds
+// its own 128-bit hash (two independently mixed 64-bit lanes). Sums can be
+// built up and taken apart incrementally, and a topping counted twice is the
+// same as two separate nodes. Hashes are taken from names, so fingerprints are
+// stable across catalog reloads and processes.
+//
+// Everything is constexpr so compile-time recipes (StaticRecipe.h) carry
+// their fingerprint as a constant.
+struct PizzaFingerprint {
+    uint64_t high;
+    uint64_t low;
+
+    constexpr PizzaFingerprint() : high(0), low(0) {}
+    constexpr PizzaFingerprint(uint64_t highBits, uint64_t lowBits) : high(highBits), low(lowBits) {}
+
+    // One portion of a topping (known to the catalog or not)
+    static constexpr PizzaFingerprint ofTopping(const char* name, size_t length, unsigned quantity = 1) {
+        return PizzaFingerprint(mix(hashName(name, length, OFFSET) ^ TOPPING_HIGH),
+                                mix(hashName(name, length, OFFSET) ^ TOPPING_LOW)) * quantity;
+    }
+
+    static constexpr PizzaFingerprint ofModifier(PizzaModifier modifier) {
+        return PizzaFingerprint(mix(hashName(ToppingCatalog::DEFAULT_MODIFIERS[modifier].name, OFFSET) ^ MODIFIER_HIGH),
+                                mix(hashName(ToppingCatalog::DEFAULT_MODIFIERS[modifier].name, OFFSET) ^ MODIFIER_LOW));
+    }
+
+    // Hash of a topping for a catalog ID, taken from its name in the catalog
+    static PizzaFingerprint ofTopping(ToppingId id, unsigned quantity = 1);
+
+    constexpr PizzaFingerprint operator+(const PizzaFingerprint& other) const {
+        return PizzaFingerprint(high + other.high, low + other.low);
+    }
+    constexpr PizzaFingerprint operator-(const PizzaFingerprint& other) const {
+        return PizzaFingerprint(high - other.high, low - other.low);
+    }
+    constexpr PizzaFingerprint operator*(unsigned count) const {
+        return PizzaFingerprint(high * count, low * count);
+    }
+    PizzaFingerprint& operator+=(const PizzaFingerprint& other) {
+        high += other.high;
+        low += other.low;
+        return *this;
+    }
+
+    constexpr bool operator==(const PizzaFingerprint& other) const {
+        return high == other.high && low == other.low;
+    }
+    constexpr bool operator!=(const PizzaFingerprint& other) const {
+        return !(*this == other);
+    }
+    constexpr bool operator<(const PizzaFingerprint& other) const {
+        return high < other.high || (high == other.high && low < other.low);
+    }
+
+    // 32 hex digits
+    std::string toString() const;
+
+private:
+    static constexpr uint64_t OFFSET = 14695981039346656037ULL;
+    static constexpr uint64_t PRIME = 1099511628211ULL;
+    static constexpr uint64_t TOPPING_HIGH = 0x9e3779b97f4a7c15ULL;
+    static constexpr uint64_t TOPPING_LOW = 0xc2b2ae3d27d4eb4fULL;
+    static constexpr uint64_t MODIFIER_HIGH = 0x165667b19e3779f9ULL;
+    static constexpr uint64_t MODIFIER_LOW = 0x27d4eb2f165667c5ULL;
+
+    // FNV-1a over the name, then a splitmix64 finaliser per lane
+    static constexpr uint64_t hashName(const char* name, size_t length, uint64_t hash) {
+        return length == 0 ? hash
+             : hashName(name + 1, length - 1, (hash ^ static_cast<unsigned char>(*name)) * PRIME);
+    }
+    static constexpr uint64_t hashName(const char* name, uint64_t hash) {
+        return *name == '\0' ? hash
+             : hashName(name + 1, (hash ^ static_cast<unsigned char>(*name)) * PRIME);
+    }
+    static constexpr uint64_t mixStep(uint64_t value, int shift, uint64_t factor) {
+        return (value ^ (value >> shift)) * factor;
+    }
+    static constexpr uint64_t mix(uint64_t value) {
+        return mixStep(mixStep(mixStep(value, 30, 0xbf58476d1ce4e5b9ULL), 27, 0x94d049bb133111ebULL), 31, 1);
+    }
+};
+
+namespace std {
+    // Lets fingerprints key unordered containers (group identical pizzas)
+    template <>
+    struct hash<PizzaFingerprint> {
+        size_t operator()(const PizzaFingerprint& fingerprint) const {
+            return static_cast<size_t>(fingerprint.high ^ (fingerprint.low * 0x9e3779b97f4a7c15ULL));
+        }
+    };
+}
+
+#endif
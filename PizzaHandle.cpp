@@ -0,0 +1,38 @@
+#include "PizzaHandle.h"
+
+PizzaHandle::PizzaHandle() : pizza(nullptr) {
+}
+
+PizzaHandle::PizzaHandle(Pizza* ownedPizza) : pizza(ownedPizza) {
+}
+
+PizzaHandle::~PizzaHandle() {
+    reset();
+}
+
+PizzaHandle::PizzaHandle(PizzaHandle&& other) noexcept : pizza(other.pizza) {
+    other.pizza = nullptr;
+}
+
+PizzaHandle& PizzaHandle::operator=(PizzaHandle&& other) noexcept {
+    if (this != &other) {
+        reset(other.pizza);
+        other.pizza = nullptr;
+    }
+    return *this;
+}
+
+PizzaHandle PizzaHandle::clone(MemoryResource& resource) const {
+    return PizzaHandle(pizza != nullptr ? pizza->cloneInto(resource) : nullptr);
+}
+
+Pizza* PizzaHandle::release() {
+    Pizza* released = pizza;
+    pizza = nullptr;
+    return released;
+}
+
+void PizzaHandle::reset(Pizza* ownedPizza) {
+    delete pizza;
+    pizza = ownedPizza;
+}
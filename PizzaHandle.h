@@ -0,0 +1,57 @@
+#ifndef PIZZAHANDLE_H
+#define PIZZAHANDLE_H
+
+#include "Pizza.h"
+#include "MemoryResource.h"
+#include <type_traits>
+#include <utility>
+
+// Move-only owner of one pizza. The pizza is adopted as a pointer and deleted
+// through its MemoryResource, so orders can build theirs in an arena and
+// menus can key their entries by address. Moving a handle moves ownership
+// with it, so containers of handles never leak or double-delete:
+//
+//   PizzaHandle pizza = PizzaHandle::make<BasePizza>(toppings);
+//   std::vector<PizzaHandle> pizzas;
+//   pizzas.push_back(std::move(pizza));
+class PizzaHandle {
+private:
+    Pizza* pizza;
+
+public:
+    // Empty handle
+    PizzaHandle();
+
+    // Adopt a pizza allocated with new or new (resource)
+    explicit PizzaHandle(Pizza* ownedPizza);
+
+    ~PizzaHandle();
+
+    PizzaHandle(PizzaHandle&& other) noexcept;
+    PizzaHandle& operator=(PizzaHandle&& other) noexcept;
+    PizzaHandle(const PizzaHandle&) = delete;
+    PizzaHandle& operator=(const PizzaHandle&) = delete;
+
+    // Build a T on the heap and adopt it
+    template <typename T, typename... Args>
+    static PizzaHandle make(Args&&... args) {
+        static_assert(std::is_base_of<Pizza, T>::value, "PizzaHandle holds pizzas");
+        return PizzaHandle(new T(std::forward<Args>(args)...));
+    }
+
+    // Deep copy of the pizza into a new handle (allocated from resource)
+    PizzaHandle clone(MemoryResource& resource = MemoryResource::heap()) const;
+
+    Pizza* get() const { return pizza; }
+    Pizza* operator->() const { return pizza; }
+    Pizza& operator*() const { return *pizza; }
+    explicit operator bool() const { return pizza != nullptr; }
+
+    // Give up ownership. Returns nullptr for an empty handle.
+    Pizza* release();
+
+    // Destroy the pizza and adopt another (or become empty)
+    void reset(Pizza* ownedPizza = nullptr);
+};
+
+#endif
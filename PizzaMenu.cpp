@@ -1,12 +1,16 @@
 #include "PizzaMenu.h"
-#include <iostream>
+#include "PizzaName.h"
 
 PizzaMenu::PizzaMenu(const std::string& name): menuName(name){
 }
 
 void PizzaMenu::notifyObservers(const std::string& message){
-    std::cout << "\n[PIZZA MENU NOTIFICATION]" << std::endl;
-    std::cout << "Broadcasting from " << menuName << ": " << message << std::endl;
+    // Printed before the observers so their output follows it
+    {
+        Document document(*outputSink);
+        document << "\n[PIZZA MENU NOTIFICATION]\n";
+        document << "Broadcasting from " << menuName << ": " << message << '\n';
+    }
     
     for(Observer* observer : observers){
 
@@ -15,7 +19,8 @@ void PizzaMenu::notifyObservers(const std::string& message){
         }
     }
 
-    std::cout << "Notification sent to " << observers.size() << " observers." << std::endl;
+    Document document(*outputSink);
+    document << "Notification sent to " << observers.size() << " observers.\n";
 }
 
 void PizzaMenu::addPizza(Pizza* pizza){
@@ -23,9 +28,16 @@ void PizzaMenu::addPizza(Pizza* pizza){
     if(pizza != nullptr){
         Menus::addPizza(pizza);
 
-        std::string message = "New pizza flavour added: " + pizza->getName() + 
-                              " is now available on our menu. Price: R" + 
-                              std::to_string(pizza->getPrice());
+        // Size the message up front so it is built with a single allocation
+        static const char prefix[] = "New pizza flavour added: ";
+        static const char suffix[] = " is now available on our menu. Price: R";
+        std::string price = pizza->getPrice().toString();
+        std::string message;
+        message.reserve(sizeof(prefix) - 1 + nameLength(*pizza) + sizeof(suffix) - 1 + price.size());
+        message += prefix;
+        appendName(message, *pizza);
+        message += suffix;
+        message += price;
 
         notifyObservers(message);
     }
@@ -34,11 +46,15 @@ void PizzaMenu::addPizza(Pizza* pizza){
 void PizzaMenu::removePizza(Pizza* pizza){
 
     if(pizza != nullptr){
-        std::string pizzaName = pizza->getName();
-        Menus::removePizza(pizza);
+        static const char prefix[] = "Pizza flavour removed: ";
+        static const char suffix[] = " is no longer available on our menu.";
+        std::string message;
+        message.reserve(sizeof(prefix) - 1 + nameLength(*pizza) + sizeof(suffix) - 1);
+        message += prefix;
+        appendName(message, *pizza);
+        message += suffix;
 
-        std::string message = "Pizza flavour removed: " + pizzaName + 
-                              " is no longer available on our menu.";
+        Menus::removePizza(pizza);
 
         notifyObservers(message);
     }
@@ -48,19 +64,38 @@ std::string PizzaMenu::getMenuName() const{
     return menuName;
 }
 
-void PizzaMenu::displayMenu() const{
-    std::cout << "\n=== " << menuName << " ===" << std::endl;
+void PizzaMenu::displayMenu(OutputSink& sink) const{
+    Document document(sink);
+    document << "\n=== " << menuName << " ===\n";
 
     if (pizzas.empty()){
-        std::cout << "No pizzas currently available." << std::endl;
+        document << "No pizzas currently available.\n";
     } 
     
     else{
         for(size_t i = 0; i < pizzas.size(); ++i){
             
-            std::cout << (i + 1) << ". " << pizzas[i]->getName() 
-                      << " - R" << pizzas[i]->getPrice() << std::endl;
+            document << (i + 1) << ". " << nameOf(*pizzas[i]) 
+                      << " - R" << pizzas[i]->getPrice() << '\n';
         }
     }
-    std::cout << "=========================" << std::endl;
-}
\ No newline at end of file
+    document << "=========================\n";
+}
+
+int PizzaMenu::loadFromImage(const CatalogImage& image){
+    int loaded = 0;
+
+    for(uint32_t i = 0; i < image.getMenuEntryCount(); ++i){
+        if(image.isSpecial(i)){
+            continue;
+        }
+
+        Pizza* pizza = image.buildMenuPizza(i);
+        if(pizza != nullptr){
+            Menus::addPizza(pizza);
+            ++loaded;
+        }
+    }
+
+    return loaded;
+}
\ No newline at end of file
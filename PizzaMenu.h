@@ -1,6 +1,7 @@
 #ifndef PIZZAMENU_H
 #define PIZZAMENU_
 #include "Menus.h"
+#include "CatalogImage.h"
 #include <string>
 
 class PizzaMenu: public Menus{
@@ -10,13 +11,18 @@ private:
 public:
     PizzaMenu(const std::string& name = "Main Menu");
     virtual ~PizzaMenu() = default;
+    PizzaMenu(PizzaMenu&& other) = default;
+    PizzaMenu& operator=(PizzaMenu&& other) = default;
     
     void notifyObservers(const std::string& message) override;
     void addPizza(Pizza* pizza) override;
     void removePizza(Pizza* pizza) override;
     
     std::string getMenuName() const;
-    void displayMenu() const;
+    void displayMenu(OutputSink& sink = OutputSink::console()) const;
+    
+    // Add the image's main menu entries without broadcasting, returns how many were added
+    int loadFromImage(const CatalogImage& image);
 };
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "PizzaName.h"
+#include "Pizza.h"
+#include "PizzaComponent.h"
+#include "ToppingCatalog.h"
+#include <cstring>
+
+NameWriter::NameWriter() : buffer(nullptr), capacity(0), length(0) {
+}
+
+NameWriter::NameWriter(char* destination, size_t destinationCapacity)
+    : buffer(destination), capacity(destinationCapacity), length(0) {
+}
+
+void NameWriter::append(const char* text, size_t textLength) {
+    if (length < capacity) {
+        size_t room = capacity - length;
+        std::memcpy(buffer + length, text, textLength < room ? textLength : room);
+    }
+    length += textLength;
+}
+
+void NameWriter::appendNumber(unsigned long value) {
+    char digits[24];
+    size_t start = sizeof(digits);
+    do {
+        digits[--start] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    append(digits + start, sizeof(digits) - start);
+}
+
+size_t nameLength(Pizza& pizza) {
+    NameWriter counter;
+    pizza.writeName(counter);
+    return counter.size();
+}
+
+size_t nameLength(const PizzaComponent& component) {
+    NameWriter counter;
+    component.writeName(counter);
+    return counter.size();
+}
+
+size_t renderName(Pizza& pizza, char* buffer, size_t capacity) {
+    NameWriter writer(buffer, capacity);
+    pizza.writeName(writer);
+    return writer.size();
+}
+
+void appendName(std::string& out, Pizza& pizza) {
+    // Both passes must see the same topping names
+    CatalogScope scope;
+    size_t start = out.size();
+    out.resize(start + nameLength(pizza));
+    NameWriter writer(&out[0] + start, out.size() - start);
+    pizza.writeName(writer);
+}
+
+std::string renderName(Pizza& pizza) {
+    std::string result;
+    appendName(result, pizza);
+    return result;
+}
+
+std::string renderName(const PizzaComponent& component) {
+    CatalogScope scope;
+    std::string result(nameLength(component), '\0');
+    NameWriter writer(&result[0], result.size());
+    component.writeName(writer);
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& out, const PizzaNameRef& name) {
+    // Typical names fit on the stack; longer ones fall back to one allocation
+    char buffer[256];
+    CatalogScope scope;
+    size_t length = renderName(name.pizza, buffer, sizeof(buffer));
+    if (length <= sizeof(buffer)) {
+        return out.write(buffer, static_cast<std::streamsize>(length));
+    }
+    return out << renderName(name.pizza);
+}
@@ -0,0 +1,71 @@
+#ifndef PIZZANAME_H
+#define PIZZANAME_H
+
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+class Pizza;
+class PizzaComponent;
+
+// Destination for a rendered name. Components and pizzas write their name
+// piece by piece with writeName(); the writer copies as much as fits into the
+// caller's buffer and always counts the full length. A writer without a buffer
+// only counts, which is how the exact size is found before anything is
+// allocated.
+class NameWriter {
+private:
+    char* buffer;
+    size_t capacity;
+    size_t length;
+
+public:
+    // Count only
+    NameWriter();
+
+    // Write into destination (never more than destinationCapacity characters)
+    NameWriter(char* destination, size_t destinationCapacity);
+
+    void append(const char* text, size_t textLength);
+    void append(const std::string& text) { append(text.data(), text.size()); }
+
+    // String literals (length known at compile time)
+    template <size_t N>
+    void append(const char (&text)[N]) { append(text, N - 1); }
+    
+    // Decimal digits of a number
+    void appendNumber(unsigned long value);
+
+    // Full length of the name, including anything that didn't fit
+    size_t size() const { return length; }
+};
+
+// Length of the full name
+size_t nameLength(Pizza& pizza);
+size_t nameLength(const PizzaComponent& component);
+
+// Write the name into a caller-supplied buffer (not null-terminated).
+// Returns the full length; the name was truncated if that exceeds capacity.
+size_t renderName(Pizza& pizza, char* buffer, size_t capacity);
+
+// Append the name to a string, growing it at most once
+void appendName(std::string& out, Pizza& pizza);
+
+// The name as a new string (a single allocation)
+std::string renderName(Pizza& pizza);
+std::string renderName(const PizzaComponent& component);
+
+// Streams a pizza's name without building a string for it:
+//   std::cout << nameOf(*pizza);
+struct PizzaNameRef {
+    Pizza& pizza;
+};
+
+inline PizzaNameRef nameOf(Pizza& pizza) {
+    PizzaNameRef ref = {pizza};
+    return ref;
+}
+
+std::ostream& operator<<(std::ostream& out, const PizzaNameRef& name);
+
+#endif
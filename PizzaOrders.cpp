@@ -1,52 +1,66 @@
 #include "PizzaOrders.h"
 #include "Topping.h"
 #include "ConcreteStates.h"
+#include "OrderLifecycle.h"
+#include "StaticDecorator.h"
 #include <iostream>
+#include <algorithm>
 
 // Constructors and Destructor
-PizzaOrders::PizzaOrders() : currentState(nullptr), discountStrat(nullptr), orderNum(0), orderName("Guest") {
-    currentState = new OrderingState();
+PizzaOrders::PizzaOrders()
+    : arena(new MonotonicArena()), currentState(&OrderingState::instance()), ownsState(false), discountStrat(nullptr),
+      orderNum(0), orderName("Guest"), pricingCatalog(ToppingCatalog::current()) {
+    resetTotals();
 }
 
 PizzaOrders::PizzaOrders(int orderNumber, const std::string& customerName) 
-    : currentState(nullptr), discountStrat(nullptr), orderNum(orderNumber), orderName(customerName) {
-        currentState = new OrderingState();
+    : arena(new MonotonicArena()), currentState(&OrderingState::instance()), ownsState(false), discountStrat(nullptr),
+      orderNum(orderNumber), orderName(customerName), pricingCatalog(ToppingCatalog::current()) {
+        resetTotals();
 }
 
 PizzaOrders::~PizzaOrders() {
     clearOrder();
     // Clean up strategy if it exists
     delete discountStrat;
-    delete currentState;
-    // Note: currentState will be managed when State pattern is implemented
+    if (ownsState) {
+        delete currentState;
+    }
 }
 
 PizzaOrders::PizzaOrders(const PizzaOrders& other) 
-    : currentState(nullptr), discountStrat(nullptr), orderNum(other.orderNum), orderName(other.orderName) {
+    : arena(new MonotonicArena()), currentState(nullptr), ownsState(false), discountStrat(nullptr), orderNum(other.orderNum), orderName(other.orderName),
+      pricingCatalog(other.pricingCatalog) {
+    resetTotals();
     // Deep copy pizzas using clone method
     for (const auto& pizza : other.pizzas) {
-        Pizza* clonedPizza = clonePizza(pizza);
+        Pizza* clonedPizza = clonePizza(pizza.get());
         if (clonedPizza != nullptr) {
-            pizzas.push_back(clonedPizza);
+            addPizza(clonedPizza);
         }
     }
 }
 
 PizzaOrders& PizzaOrders::operator=(const PizzaOrders& other) {
     if (this != &other) {
+        // The pizzas go before the arena they live in, which is reused for the copies
         clearOrder();
+        if (arena) {
+            arena->reset();
+        }
         // Clean up existing strategy
         delete discountStrat;
         discountStrat = nullptr;
         
         orderNum = other.orderNum;
         orderName = other.orderName;
+        pricingCatalog = other.pricingCatalog;
         
         // Deep copy pizzas using clone method
         for (const auto& pizza : other.pizzas) {
-            Pizza* clonedPizza = clonePizza(pizza);
+            Pizza* clonedPizza = clonePizza(pizza.get());
             if (clonedPizza != nullptr) {
-                pizzas.push_back(clonedPizza);
+                addPizza(clonedPizza);
             }
         }
         
@@ -56,16 +70,105 @@ PizzaOrders& PizzaOrders::operator=(const PizzaOrders& other) {
     return *this;
 }
 
+PizzaOrders::PizzaOrders(PizzaOrders&& other) noexcept
+    : arena(std::move(other.arena)), pizzas(std::move(other.pizzas)),
+      linePrices(std::move(other.linePrices)), subtotal(other.subtotal),
+      currentState(other.currentState), ownsState(other.ownsState), discountStrat(other.discountStrat),
+      orderNum(other.orderNum), orderName(std::move(other.orderName)),
+      pricingCatalog(other.pricingCatalog) {
+    std::copy(other.modifierCounts, other.modifierCounts + PIZZA_MODIFIER_COUNT, modifierCounts);
+    other.pizzas.clear();
+    other.resetTotals();
+    other.currentState = nullptr;
+    other.ownsState = false;
+    other.discountStrat = nullptr;
+}
+
+PizzaOrders& PizzaOrders::operator=(PizzaOrders&& other) noexcept {
+    if (this != &other) {
+        // The pizzas go before the arena they live in
+        clearOrder();
+        delete discountStrat;
+        if (ownsState) {
+            delete currentState;
+        }
+        
+        arena = std::move(other.arena);
+        pizzas = std::move(other.pizzas);
+        linePrices = std::move(other.linePrices);
+        subtotal = other.subtotal;
+        std::copy(other.modifierCounts, other.modifierCounts + PIZZA_MODIFIER_COUNT, modifierCounts);
+        currentState = other.currentState;
+        ownsState = other.ownsState;
+        discountStrat = other.discountStrat;
+        orderNum = other.orderNum;
+        orderName = std::move(other.orderName);
+        pricingCatalog = other.pricingCatalog;
+        
+        other.pizzas.clear();
+        other.resetTotals();
+        other.currentState = nullptr;
+        other.ownsState = false;
+        other.discountStrat = nullptr;
+    }
+    return *this;
+}
+
+MonotonicArena& PizzaOrders::memory() {
+    if (!arena) {
+        arena.reset(new MonotonicArena());
+    }
+    return *arena;
+}
+
+void PizzaOrders::countPizza(Pizza* pizza, Money price, int sign) {
+    subtotal += price * sign;
+    for (PizzaDecorator* decorator = pizza->asDecorator(); decorator != nullptr;
+         decorator = decorator->getWrappedPizza() != nullptr ? decorator->getWrappedPizza()->asDecorator() : nullptr) {
+        for (size_t i = 0; i < decorator->getModifierCount(); ++i) {
+            modifierCounts[decorator->getModifier(i)] += sign;
+        }
+    }
+}
+
+void PizzaOrders::resetTotals() {
+    linePrices.clear();
+    subtotal = Money();
+    std::fill(modifierCounts, modifierCounts + PIZZA_MODIFIER_COUNT, 0);
+}
+
+void PizzaOrders::recalculateTotals() {
+    resetTotals();
+    CatalogScope scope(pricingCatalog);
+    linePrices.reserve(pizzas.size());
+    for (const PizzaHandle& pizza : pizzas) {
+        linePrices.push_back(pizza->getPrice());
+        countPizza(pizza.get(), linePrices.back(), 1);
+    }
+}
+
 // Basic order management
 void PizzaOrders::addPizza(Pizza* pizza) {
     if (pizza != nullptr) {
-        pizzas.push_back(pizza);
+        addPizza(PizzaHandle(pizza));
+    }
+}
+
+void PizzaOrders::addPizza(PizzaHandle&& pizza) {
+    if (pizza) {
+        // Priced once, under the order's catalog
+        CatalogScope scope(pricingCatalog);
+        Money price = pizza->getPrice();
+        countPizza(pizza.get(), price, 1);
+        linePrices.push_back(price);
+        pizzas.push_back(std::move(pizza));
     }
 }
 
 bool PizzaOrders::removePizza(int index) {
     if (index >= 0 && index < static_cast<int>(pizzas.size())) {
-        delete pizzas[index];
+        countPizza(pizzas[index].get(), linePrices[index], -1);
+        linePrices.erase(linePrices.begin() + index);
         pizzas.erase(pizzas.begin() + index);
         return true;
     }
@@ -73,95 +176,102 @@ bool PizzaOrders::removePizza(int index) {
 }
 
 void PizzaOrders::clearOrder() {
-    for (auto& pizza : pizzas) {
-        delete pizza;
-    }
     pizzas.clear();
+    resetTotals();
 }
 
-// Pizza creation methods (non-interactive)
-Pizza* PizzaOrders::createPepperoniPizza(bool extraCheese, bool stuffedCrust) {
-    ToppingGroup* toppings = ToppingGroup::createPepperoniPizza();
-    Pizza* pizza = new BasePizza(toppings);
-    
-    if (extraCheese) {
-        pizza = new ExtraCheese(pizza);
+void PizzaOrders::recycle() {
+    // The pizzas go before the arena they live in
+    clearOrder();
+    if (arena) {
+        arena->reset();
     }
-    if (stuffedCrust) {
-        pizza = new StuffedCrust(pizza);
+    setDiscountStrategy(nullptr);
+    setState(OrderingState::instance());
+    pricingCatalog.release();
+}
+
+void PizzaOrders::reopen(int orderNumber, const std::string& customerName) {
+    orderNum = orderNumber;
+    orderName = customerName;
+    pricingCatalog = ToppingCatalog::current();
+}
+
+void PizzaOrders::reset(int orderNumber, const std::string& customerName) {
+    recycle();
+    reopen(orderNumber, customerName);
+}
+
+size_t PizzaOrders::getRetainedBytes() const {
+    return (arena ? arena->getBytesReserved() : 0) +
+           pizzas.capacity() * sizeof(PizzaHandle) +
+           linePrices.capacity() * sizeof(Money) +
+           orderName.capacity();
+}
+
+// Pizza creation methods (non-interactive)
+Pizza* PizzaOrders::createPizza(const std::string& recipeName, bool extraCheese, bool stuffedCrust) {
+    // Shares the recipe's prototype, so no tree is built
+    ToppingGroup* toppings = RecipeRegistry::instantiate(recipeName, memory());
+    if (toppings == nullptr) {
+        std::cerr << "Error: Unknown recipe '" << recipeName << "'." << std::endl;
+        return nullptr;
     }
-    
-    return pizza;
+    return decorate(new (memory()) BasePizza(toppings), extraCheese, stuffedCrust);
+}
+
+Pizza* PizzaOrders::createPepperoniPizza(bool extraCheese, bool stuffedCrust) {
+    return createPizza("Pepperoni", extraCheese, stuffedCrust);
 }
 
 Pizza* PizzaOrders::createVegetarianPizza(bool extraCheese, bool stuffedCrust) {
-    ToppingGroup* toppings = ToppingGroup::createVegetarianPizza();
-    Pizza* pizza = new BasePizza(toppings);
-    
-    if (extraCheese) {
-        pizza = new ExtraCheese(pizza);
-    }
-    if (stuffedCrust) {
-        pizza = new StuffedCrust(pizza);
-    }
-    
-    return pizza;
+    return createPizza("Vegetarian", extraCheese, stuffedCrust);
 }
 
 Pizza* PizzaOrders::createMeatLoversPizza(bool extraCheese, bool stuffedCrust) {
-    ToppingGroup* toppings = ToppingGroup::createMeatLoversPizza();
-    Pizza* pizza = new BasePizza(toppings);
-    
-    if (extraCheese) {
-        pizza = new ExtraCheese(pizza);
-    }
-    if (stuffedCrust) {
-        pizza = new StuffedCrust(pizza);
-    }
-    
-    return pizza;
+    return createPizza("Meat Lovers", extraCheese, stuffedCrust);
 }
 
 Pizza* PizzaOrders::createVegetarianDeluxePizza(bool extraCheese, bool stuffedCrust) {
-    ToppingGroup* toppings = ToppingGroup::createVegetarianDeluxePizza();
-    Pizza* pizza = new BasePizza(toppings);
-    
-    if (extraCheese) {
-        pizza = new ExtraCheese(pizza);
-    }
-    if (stuffedCrust) {
-        pizza = new StuffedCrust(pizza);
-    }
-    
-    return pizza;
+    return createPizza("Vegetarian Deluxe", extraCheese, stuffedCrust);
 }
 
 Pizza* PizzaOrders::createCustomPizza(const std::vector<std::string>& toppings, bool extraCheese, bool stuffedCrust) {
-    ToppingGroup* customToppings = new ToppingGroup("Custom Pizza");
-    
-    // Add base ingredients
-    ToppingGroup* base = new ToppingGroup("Base");
-    base->addComponent(new Topping("Dough"));
-    base->addComponent(new Topping("Tomato Sauce"));
-    base->addComponent(new Topping("Cheese"));
-    customToppings->addComponent(base);
-    
-    // Add custom toppings
+    // Resolve topping names to catalog IDs once, skipping unknown names
+    CatalogSnapshot catalog = ToppingCatalog::current();
+    std::vector<ToppingId> toppingIds;
+    toppingIds.reserve(toppings.size());
     for (const std::string& topping : toppings) {
-        if (Topping::isValidTopping(topping)) {
-            customToppings->addComponent(new Topping(topping));
+        ToppingId id = catalog->findId(topping);
+        if (id != ToppingCatalog::INVALID_ID) {
+            toppingIds.push_back(id);
         }
     }
     
-    Pizza* pizza = new BasePizza(customToppings);
+    // Start from the shared base recipe and add the toppings
+    ToppingGroup* customToppings = new (memory()) ToppingGroup("Custom Pizza", memory());
+    ToppingGroup* base = RecipeRegistry::instantiate("Base", memory());
+    if (base != nullptr) {
+        customToppings->addComponent(base);
+    }
+    // "Pepperoni", "Pepperoni" becomes one topping counted twice
+    for (ToppingId id : toppingIds) {
+        customToppings->addTopping(id);
+    }
     
+    return decorate(new (memory()) BasePizza(customToppings), extraCheese, stuffedCrust);
+}
+
+Pizza* PizzaOrders::decorate(BasePizza* pizza, bool extraCheese, bool stuffedCrust) {
+    if (extraCheese && stuffedCrust) {
+        return new (memory()) StaticDecorator<BasePizza, EXTRA_CHEESE, STUFFED_CRUST>(pizza);
+    }
     if (extraCheese) {
-        pizza = new ExtraCheese(pizza);
+        return new (memory()) StaticDecorator<BasePizza, EXTRA_CHEESE>(pizza);
     }
     if (stuffedCrust) {
-        pizza = new StuffedCrust(pizza);
+        return new (memory()) StaticDecorator<BasePizza, STUFFED_CRUST>(pizza);
     }
-    
     return pizza;
 }
 
@@ -170,10 +280,19 @@ int PizzaOrders::getPizzaCount() const {
     return static_cast<int>(pizzas.size());
 }
 
-double PizzaOrders::getTotalPrice() const {
-    double total = 0.0;
-    for (const auto& pizza : pizzas) {
-        total += pizza->getPrice();
+Money PizzaOrders::getTotalPrice() const {
+    return subtotal;
+}
+
+int PizzaOrders::getModifierCount(PizzaModifier modifier) const {
+    return modifier < PIZZA_MODIFIER_COUNT ? modifierCounts[modifier] : 0;
+}
+
+Money PizzaOrders::getAddOnTotal() const {
+    Money total;
+    for (size_t i = 0; i < PIZZA_MODIFIER_COUNT; ++i) {
+        PizzaModifier modifier = static_cast<PizzaModifier>(i);
+        total += pricingCatalog->getModifierPrice(modifier) * modifierCounts[i];
     }
     return total;
 }
@@ -184,11 +303,20 @@ Pizza* PizzaOrders::clonePizza(Pizza* original) {
     }
     
     // Use the clone method - much simpler!
-    return original->clone();
+    return original->cloneInto(memory());
+}
+
+size_t PizzaOrders::getArenaBytesUsed() const {
+    return arena ? arena->getBytesUsed() : 0;
 }
 
 std::vector<Pizza*> PizzaOrders::getPizzas() const {
-    return pizzas;
+    std::vector<Pizza*> view;
+    view.reserve(pizzas.size());
+    for (const PizzaHandle& pizza : pizzas) {
+        view.push_back(pizza.get());
+    }
+    return view;
 }
 
 int PizzaOrders::getOrderNumber() const {
@@ -200,45 +328,67 @@ std::string PizzaOrders::getOrderName() const {
 }
 
 // Display methods
-void PizzaOrders::displayOrder() const {
-    std::cout << "\n=========================================" << std::endl;
-    std::cout << "           ORDER #" << orderNum << std::endl;
-    std::cout << "           Customer: " << orderName << std::endl;
-    std::cout << "=========================================" << std::endl;
+void PizzaOrders::displayOrder(OutputSink& sink) const {
+    CatalogScope scope(pricingCatalog);
+    Document document(sink);
+    document << "\n=========================================\n";
+    document << "           ORDER #" << orderNum << '\n';
+    document << "           Customer: " << orderName << '\n';
+    document << "=========================================\n";
     
     if (pizzas.empty()) {
-        std::cout << "No pizzas in order." << std::endl;
+        document << "No pizzas in order.\n";
     } else {
         for (size_t i = 0; i < pizzas.size(); ++i) {
-            std::cout << "Pizza " << (i + 1) << ":" << std::endl;
-            pizzas[i]->printPizza();
-            std::cout << std::endl;
+            document << "Pizza " << (i + 1) << ":\n";
+            pizzas[i]->renderPizza(document);
+            document << '\n';
         }
     }
     
-    std::cout << "Total Pizzas: " << getPizzaCount() << std::endl;
-    std::cout << "Subtotal: R" << getTotalPrice() << std::endl;
+    document << "Total Pizzas: " << getPizzaCount() << '\n';
+    document << "Subtotal: R" << getTotalPrice() << '\n';
     
     // Display discount information if strategy is set
     if (discountStrat != nullptr) {
-        double discount = getDiscountAmount();
-        if (discount > 0.0) {
-            std::cout << "Discount (" << discountStrat->getStrategyName() << "): -R" << discount << std::endl;
-            std::cout << "Final Total: R" << getDiscountedTotal() << std::endl;
+        Money discount = getDiscountAmount();
+        if (discount > Money()) {
+            document << "Discount (" << discountStrat->getStrategyName() << "): -R" << discount << '\n';
+            document << "Final Total: R" << getDiscountedTotal() << '\n';
         } else {
-            std::cout << "Final Total: R" << getTotalPrice() << " (no discount qualified)" << std::endl;
+            document << "Final Total: R" << getTotalPrice() << " (no discount qualified)\n";
         }
     } else {
-        std::cout << "Final Total: R" << getTotalPrice() << std::endl;
+        document << "Final Total: R" << getTotalPrice() << '\n';
     }
-    std::cout << "=========================================" << std::endl;
+    document << "=========================================\n";
+}
+
+void PizzaOrders::displayOrderSummary(OutputSink& sink) const {
+    Document document(sink);
+    document << "\n--- Order Summary ---\n";
+    document << "Order #" << orderNum << " - " << orderName << '\n';
+    document << "Pizzas: " << getPizzaCount() << '\n';
+    document << "Total: R" << (discountStrat != nullptr ? getDiscountedTotal() : getTotalPrice()) << '\n';
 }
 
-void PizzaOrders::displayOrderSummary() const {
-    std::cout << "\n--- Order Summary ---" << std::endl;
-    std::cout << "Order #" << orderNum << " - " << orderName << std::endl;
-    std::cout << "Pizzas: " << getPizzaCount() << std::endl;
-    std::cout << "Total: R" << (discountStrat != nullptr ? getDiscountedTotal() : getTotalPrice()) << std::endl;
+// Catalog version tracking
+unsigned long PizzaOrders::getCatalogVersion() const {
+    return pricingCatalog->getVersion();
+}
+
+const CatalogSnapshot& PizzaOrders::getPricingCatalog() const {
+    return pricingCatalog;
+}
+
+bool PizzaOrders::refreshCatalog() {
+    // Prices are locked in once the order leaves the Ordering state
+    if (!canModifyOrder()) {
+        return false;
+    }
+    pricingCatalog = ToppingCatalog::current();
+    recalculateTotals();
+    return true;
 }
 
 // Setters
@@ -261,41 +411,53 @@ DiscountStrategy* PizzaOrders::getDiscountStrategy() const {
     return discountStrat;
 }
 
-double PizzaOrders::getDiscountAmount() const {
+Money PizzaOrders::getDiscountAmount() const {
     if (discountStrat == nullptr) {
-        return 0.0;
+        return Money();
     }
     return discountStrat->applyDiscount(*this);
 }
 
-double PizzaOrders::getDiscountedTotal() const {
-    double originalTotal = getTotalPrice();
-    double discount = getDiscountAmount();
+Money PizzaOrders::getDiscountedTotal() const {
+    Money originalTotal = getTotalPrice();
+    Money discount = getDiscountAmount();
     return originalTotal - discount;
 }
 
-void PizzaOrders::displayDiscountInfo() const {
-    double originalTotal = getTotalPrice();
-    double discount = getDiscountAmount();
-    double finalTotal = originalTotal - discount;
+void PizzaOrders::displayDiscountInfo(OutputSink& sink) const {
+    Money originalTotal = getTotalPrice();
+    Money discount = getDiscountAmount();
+    Money finalTotal = originalTotal - discount;
+    Document document(sink);
     
-    std::cout << "\n--- Pricing Breakdown ---" << std::endl;
-    std::cout << "Subtotal: R" << originalTotal << std::endl;
+    document << "\n--- Pricing Breakdown ---\n";
+    document << "Subtotal: R" << originalTotal << '\n';
     
-    if (discountStrat != nullptr && discount > 0.0) {
-        std::cout << "Discount (" << discountStrat->getStrategyName() << "): -R" << discount << std::endl;
-        std::cout << "Final Total: R" << finalTotal << std::endl;
-        std::cout << "You saved: R" << discount << "!" << std::endl;
+    if (discountStrat != nullptr && discount > Money()) {
+        document << "Discount (" << discountStrat->getStrategyName() << "): -R" << discount << '\n';
+        document << "Final Total: R" << finalTotal << '\n';
+        document << "You saved: R" << discount << "!\n";
     } else {
-        std::cout << "No discount applied" << std::endl;
-        std::cout << "Final Total: R" << finalTotal << std::endl;
+        document << "No discount applied\n";
+        document << "Final Total: R" << finalTotal << '\n';
     }
 }
 
 // State pattern methods implementation
 void PizzaOrders::setState(OrderState* state) {
-    delete currentState;
+    if (ownsState) {
+        delete currentState;
+    }
     currentState = state;
+    ownsState = state != nullptr;
+}
+
+void PizzaOrders::setState(OrderState& sharedState) {
+    if (ownsState) {
+        delete currentState;
+    }
+    currentState = &sharedState;
+    ownsState = false;
 }
 
 OrderState* PizzaOrders::getCurrentState() const {
@@ -323,59 +485,44 @@ bool PizzaOrders::canModifyOrder() const {
     return false;
 }
 
-void PizzaOrders::displayStateInfo() const {
-    std::cout << "\n--- Order State Information ---" << std::endl;
-    std::cout << "Current State: " << getCurrentStateName() << std::endl;
-    std::cout << "Available Actions: " << getAvailableActions() << std::endl;
-    std::cout << "Can Modify Order: " << (canModifyOrder() ? "Yes" : "No") << std::endl;
-    std::cout << "------------------------------" << std::endl;
+void PizzaOrders::displayStateInfo(OutputSink& sink) const {
+    Document document(sink);
+    document << "\n--- Order State Information ---\n";
+    document << "Current State: " << getCurrentStateName() << '\n';
+    document << "Available Actions: " << getAvailableActions() << '\n';
+    document << "Can Modify Order: " << (canModifyOrder() ? "Yes" : "No") << '\n';
+    document << "------------------------------\n";
 }
 
-// State-delegated operations
+// State-delegated operations (looked up in the lifecycle table)
 void PizzaOrders::performAddPizza() {
-    if (currentState != nullptr) {
-        currentState->addPizza(this);
-    }
+    OrderLifecycle::dispatch(*this, ADD_PIZZA);
 }
 
 void PizzaOrders::performRemovePizza(int index) {
-    if (currentState != nullptr) {
-        currentState->removePizza(this, index);
-    }
+    OrderLifecycle::dispatch(*this, REMOVE_PIZZA, index);
 }
 
 void PizzaOrders::performConfirmOrder() {
-    if (currentState != nullptr) {
-        currentState->confirmOrder(this);
-    }
+    OrderLifecycle::dispatch(*this, CONFIRM_ORDER);
 }
 
 void PizzaOrders::performCancelOrder() {
-    if (currentState != nullptr) {
-        currentState->cancelOrder(this);
-    }
+    OrderLifecycle::dispatch(*this, CANCEL_ORDER);
 }
 
 void PizzaOrders::performPayOrder() {
-    if (currentState != nullptr) {
-        currentState->payOrder(this);
-    }
+    OrderLifecycle::dispatch(*this, PAY_ORDER);
 }
 
 void PizzaOrders::performPrepareOrder() {
-    if (currentState != nullptr) {
-        currentState->prepareOrder(this);
-    }
+    OrderLifecycle::dispatch(*this, PREPARE_ORDER);
 }
 
 void PizzaOrders::performDeliverOrder() {
-    if (currentState != nullptr) {
-        currentState->deliverOrder(this);
-    }
+    OrderLifecycle::dispatch(*this, DELIVER_ORDER);
 }
 
 void PizzaOrders::performCompleteOrder() {
-    if (currentState != nullptr) {
-        currentState->completeOrder(this);
-    }
+    OrderLifecycle::dispatch(*this, COMPLETE_ORDER);
 }
\ No newline at end of file
@@ -8,6 +8,12 @@
 #include "StuffedCrust.h"
 #include <vector>
 #include "DiscountStrategy.h"
+#include "ToppingCatalog.h"
+#include "MemoryResource.h"
+#include "RecipeRegistry.h"
+#include "PizzaHandle.h"
+#include "OutputSink.h"
+#include <memory>
 
 // Forward declarations for State and Strategy patterns
 class OrderState;
@@ -15,11 +21,51 @@ class DiscountStrategy;
 
 class PizzaOrders {
 private:
-    std::vector<Pizza*> pizzas;
+    // Every pizza the order creates or copies is allocated from this arena,
+    // so the memory of the whole order is returned in one step when the
+    // order is destroyed. Pizzas from create*Pizza must not outlive the order.
+    // Held by pointer so that moving the order keeps its address (pizzas and
+    // groups remember the resource they came from).
+    std::unique_ptr<MonotonicArena> arena;
+    std::vector<PizzaHandle> pizzas;
+    
+    // Running totals, kept up to date by every change to the pizzas so
+    // total queries never walk the pizza trees. linePrices[i] is the price of
+    // pizzas[i] under pricingCatalog.
+    std::vector<Money> linePrices;
+    Money subtotal;
+    int modifierCounts[PIZZA_MODIFIER_COUNT];
+    
     OrderState* currentState;
+    bool ownsState;  // currentState was adopted through setState(OrderState*)
     DiscountStrategy* discountStrat;
     int orderNum;
     std::string orderName;
+    CatalogSnapshot pricingCatalog; // Catalog version this order is priced under
+    
+    // The two halves of reset(), split so OrderPool can empty an order when
+    // it comes back and name it when it goes out again. recycle() also
+    // drops the catalog pin, so an idle order doesn't hold a retired
+    // snapshot; the order can't be used until reopen() pins the latest one.
+    friend class OrderPool;
+    void recycle();
+    void reopen(int orderNumber, const std::string& customerName);
+    
+    // Wrap a pizza in the requested decorators (allocated from the arena).
+    // Each combination is a StaticDecorator, priced without virtual dispatch.
+    Pizza* decorate(BasePizza* pizza, bool extraCheese, bool stuffedCrust);
+    
+    // The order's arena (a moved-from order gets a new one on first use)
+    MonotonicArena& memory();
+    
+    // Add a pizza's price and add-ons to the running totals (sign 1) or
+    // take them off again (sign -1)
+    void countPizza(Pizza* pizza, Money price, int sign);
+    
+    // Zero the running totals, or rebuild them from the pizzas under the
+    // pricing catalog
+    void resetTotals();
+    void recalculateTotals();
 
 public:
     // Constructors and Destructor
@@ -30,30 +76,73 @@ public:
     // Copy constructor and assignment operator
     PizzaOrders(const PizzaOrders& other);
     PizzaOrders& operator=(const PizzaOrders& other);
-    Pizza* clonePizza(Pizza* original);
+    Pizza* clonePizza(Pizza* original);  // The copy lives in this order's arena
     
-    // Basic order management
+    // Moving hands over the pizzas, arena, state and discount without cloning.
+    // The moved-from order is empty, with no state or discount.
+    PizzaOrders(PizzaOrders&& other) noexcept;
+    PizzaOrders& operator=(PizzaOrders&& other) noexcept;
+    
+    // Basic order management (the order takes ownership)
     void addPizza(Pizza* pizza);
+    void addPizza(PizzaHandle&& pizza);
     bool removePizza(int index);
     void clearOrder();
     
-    // Pizza creation methods (non-interactive, parameter-driven)
-    Pizza* createPepperoniPizza(bool extraCheese = false, bool stuffedCrust = false);
-    Pizza* createVegetarianPizza(bool extraCheese = false, bool stuffedCrust = false);
-    Pizza* createMeatLoversPizza(bool extraCheese = false, bool stuffedCrust = false);
-    Pizza* createVegetarianDeluxePizza(bool extraCheese = false, bool stuffedCrust = false);
+    // Turn the order into a new, empty order in the Ordering state with no
+    // discount, priced with the latest catalog. The pizza list capacity and
+    // the arena's largest chunk are kept for reuse (see OrderPool); pizzas
+    // from create*Pizza are gone afterwards, whether added or not.
+    void reset(int orderNumber, const std::string& customerName);
+    
+    // Heap memory the order holds on to between uses (arena chunks, list
+    // capacity), not counting the order object itself
+    size_t getRetainedBytes() const;
+    
+    // Pizza creation methods (non-interactive, parameter-driven).
+    // createPizza takes any recipe from the RecipeRegistry (nullptr if it is
+    // unknown); the named ones are shorthands for the predefined recipes.
+    //
+    // The pizzas live in the order's arena: pass them to addPizza (or
+    // delete them) while the order is alive, and don't use them after the
+    // order is reset, recycled or destroyed. To keep a pizza beyond that,
+    // take a heap copy with Pizza::clone().
+    Pizza* createPizza(const std::string& recipeName, bool extraCheese = false, bool stuffedCrust = false);
+    Pizza* createPepperoniPizza(bool extraCheese = false, bool stuffedCrust = false);      // In the arena, see above
+    Pizza* createVegetarianPizza(bool extraCheese = false, bool stuffedCrust = false);     // In the arena, see above
+    Pizza* createMeatLoversPizza(bool extraCheese = false, bool stuffedCrust = false);     // In the arena, see above
+    Pizza* createVegetarianDeluxePizza(bool extraCheese = false, bool stuffedCrust = false); // In the arena, see above
+    // The "Base" recipe plus the given toppings (unknown names are skipped,
+    // repeated names are counted); in the arena like the pizzas above
     Pizza* createCustomPizza(const std::vector<std::string>& toppings, bool extraCheese = false, bool stuffedCrust = false);
     
-    // Order information getters
+    // Order information getters. Totals are kept as pizzas are added and
+    // removed, so they cost the same for one pizza or hundreds.
     int getPizzaCount() const;
-    double getTotalPrice() const;
+    size_t getArenaBytesUsed() const;
+    Money getTotalPrice() const;
+    
+    // Number of pizzas carrying an add-on, and what the add-ons cost in total
+    int getModifierCount(PizzaModifier modifier) const;
+    Money getAddOnTotal() const;
+    
+    // Borrowed pointers, valid until the order's pizzas change. The order's
+    // totals assume the pizzas are not edited while they are in the order.
     std::vector<Pizza*> getPizzas() const;
     int getOrderNumber() const;
     std::string getOrderName() const;
     
-    // Display methods for order information
-    void displayOrder() const;
-    void displayOrderSummary() const;
+    // Display methods for order information. Each prints one document to
+    // sink (the console by default); see OutputSink.h.
+    void displayOrder(OutputSink& sink = OutputSink::console()) const;
+    void displayOrderSummary(OutputSink& sink = OutputSink::console()) const;
+    
+    // Catalog version the order is priced under (pinned when the order is created)
+    unsigned long getCatalogVersion() const;
+    const CatalogSnapshot& getPricingCatalog() const;
+    
+    // Re-price the order with the latest catalog (only while it can be modified)
+    bool refreshCatalog();
     
     // Setters for order details
     void setOrderNumber(int orderNumber);
@@ -62,19 +151,24 @@ public:
     // Strategy pattern methods for discount handling
     void setDiscountStrategy(DiscountStrategy* strategy);
     DiscountStrategy* getDiscountStrategy() const;
-    double getDiscountAmount() const;
-    double getDiscountedTotal() const;
-    void displayDiscountInfo() const;
+    Money getDiscountAmount() const;
+    Money getDiscountedTotal() const;
+    void displayDiscountInfo(OutputSink& sink = OutputSink::console()) const;
     
-    // State pattern methods
+    // State pattern methods. setState(OrderState*) adopts a state created
+    // with new; setState(OrderState&) switches to a shared instance (such as
+    // ConfirmedState::instance()) without taking ownership, which is how the
+    // transitions move an order along without allocating.
     void setState(OrderState* state);
+    void setState(OrderState& sharedState);
     OrderState* getCurrentState() const;
     std::string getCurrentStateName() const;
     std::string getAvailableActions() const;
     bool canModifyOrder() const;
-    void displayStateInfo() const;
+    void displayStateInfo(OutputSink& sink = OutputSink::console()) const;
     
-    // State-delegated operations
+    // State-delegated operations: each dispatches one event through
+    // OrderLifecycle's transition table
     void performAddPizza();
     void performRemovePizza(int index);
     void performConfirmOrder();
@@ -0,0 +1,299 @@
+#include "PriceBatch.h"
+#include "Pizza.h"
+#include "BasePizza.h"
+#include "PizzaDecorator.h"
+#include "PizzaComponent.h"
+#include "Topping.h"
+#include "ToppingGroup.h"
+#include "FrozenRecipe.h"
+#include <algorithm>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define PRICEBATCH_HAS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    // totals[p] = sum of prices[ids[i]] * quantities[i] over pizza p's
+    // entries, which run from ends[p - 1] (0 for the first) to ends[p].
+    // Every ID must index prices.
+    typedef void (*TotalsKernel)(const int64_t* prices, const ToppingId* ids, const uint32_t* quantities,
+                                 const uint32_t* ends, size_t pizzaCount, int64_t* totals);
+
+    void totalsScalar(const int64_t* prices, const ToppingId* ids, const uint32_t* quantities,
+                      const uint32_t* ends, size_t pizzaCount, int64_t* totals) {
+        uint32_t begin = 0;
+        for (size_t p = 0; p < pizzaCount; ++p) {
+            int64_t total = 0;
+            for (uint32_t i = begin; i < ends[p]; ++i) {
+                total += prices[ids[i]] * static_cast<int64_t>(quantities[i]);
+            }
+            totals[p] = total;
+            begin = ends[p];
+        }
+    }
+
+#ifdef PRICEBATCH_HAS_AVX2
+    // Four entries per step: gather four prices, widen four counts, multiply
+    // and add into four running sums, which are folded into the pizza's
+    // total at its end. AVX2 has no 64-bit multiply, so each price is split
+    // into 32-bit halves (the products and sums wrap the same way the scalar
+    // ones do).
+    __attribute__((target("avx2")))
+    void totalsAvx2(const int64_t* prices, const ToppingId* ids, const uint32_t* quantities,
+                    const uint32_t* ends, size_t pizzaCount, int64_t* totals) {
+        const long long* table = reinterpret_cast<const long long*>(prices);
+        uint32_t begin = 0;
+        for (size_t p = 0; p < pizzaCount; ++p) {
+            uint32_t i = begin;
+            __m256i sums = _mm256_setzero_si256();
+            for (; i + 4 <= ends[p]; i += 4) {
+                __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids + i));
+                __m256i price = _mm256_i32gather_epi64(table, index, 8);
+                __m256i portions = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(quantities + i)));
+                __m256i low = _mm256_mul_epu32(price, portions);
+                __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(price, 32), portions);
+                sums = _mm256_add_epi64(sums, _mm256_add_epi64(low, _mm256_slli_epi64(high, 32)));
+            }
+            __m128i pairs = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+            int64_t total = _mm_cvtsi128_si64(pairs) + _mm_extract_epi64(pairs, 1);
+            for (; i < ends[p]; ++i) {
+                total += prices[ids[i]] * static_cast<int64_t>(quantities[i]);
+            }
+            totals[p] = total;
+            begin = ends[p];
+        }
+    }
+#endif
+
+    bool cpuHasAvx2() {
+#ifdef PRICEBATCH_HAS_AVX2
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+    // The kernel to run for a request; AVX2 falls back to scalar on CPUs without it
+    TotalsKernel kernelFor(PriceBatch::Kernel kernel) {
+#ifdef PRICEBATCH_HAS_AVX2
+        if (kernel != PriceBatch::SCALAR && cpuHasAvx2()) {
+            return totalsAvx2;
+        }
+#endif
+        (void)kernel;
+        return totalsScalar;
+    }
+}
+
+PriceBatch::PriceBatch(Pizza* const* pizzas, size_t count) : maxId(ToppingCatalog::INVALID_ID), catalogSize(0) {
+    CatalogScope scope;
+    catalogSize = scope.catalog().size();
+    reservePizzas(count, count * TYPICAL_TOPPINGS);
+
+    for (size_t i = 0; i < count; ++i) {
+        beginPizza();
+        size_t firstEntry = toppingIds.size();
+        if (!appendPizza(pizzas[i])) {
+            // Drop what was flattened so far and price this one the slow way
+            toppingIds.resize(firstEntry);
+            quantities.resize(firstEntry);
+            fixedCents.back() = 0;
+            std::fill(modifierCounts.end() - PIZZA_MODIFIER_COUNT, modifierCounts.end(), 0);
+            fallbacks.back() = pizzas[i];
+        }
+        entryEnds.back() = static_cast<uint32_t>(toppingIds.size());
+    }
+}
+
+PriceBatch::PriceBatch(const FrozenRecipe* const* recipes, size_t count) : maxId(ToppingCatalog::INVALID_ID), catalogSize(0) {
+    CatalogScope scope;
+    catalogSize = scope.catalog().size();
+    size_t nodes = 0;
+    for (size_t i = 0; i < count; ++i) {
+        nodes += recipes[i] != nullptr ? recipes[i]->kinds.size() : 0;
+    }
+    reservePizzas(count, nodes);
+
+    for (size_t i = 0; i < count; ++i) {
+        beginPizza();
+        const FrozenRecipe* recipe = recipes[i];
+        if (recipe != nullptr) {
+            for (size_t node = 0; node < recipe->kinds.size(); ++node) {
+                if (recipe->kinds[node] != FrozenRecipe::TOPPING) {
+                    continue;
+                }
+                // IDs outside the catalog keep the price stored at freeze time
+                if (!appendTopping(recipe->toppingIds[node], recipe->quantities[node])) {
+                    fixedCents.back() += recipe->prices[node];
+                }
+            }
+            for (uint8_t modifier : recipe->modifiers) {
+                if (modifier < PIZZA_MODIFIER_COUNT) {
+                    ++modifierCounts[modifierCounts.size() - PIZZA_MODIFIER_COUNT + modifier];
+                }
+            }
+        }
+        entryEnds.back() = static_cast<uint32_t>(toppingIds.size());
+    }
+}
+
+void PriceBatch::reservePizzas(size_t count, size_t entries) {
+    toppingIds.reserve(entries);
+    quantities.reserve(entries);
+    entryEnds.reserve(count);
+    fixedCents.reserve(count);
+    modifierCounts.reserve(count * PIZZA_MODIFIER_COUNT);
+    fallbacks.reserve(count);
+}
+
+void PriceBatch::beginPizza() {
+    entryEnds.push_back(static_cast<uint32_t>(toppingIds.size()));
+    fixedCents.push_back(0);
+    modifierCounts.insert(modifierCounts.end(), PIZZA_MODIFIER_COUNT, 0);
+    fallbacks.push_back(nullptr);
+}
+
+bool PriceBatch::appendPizza(Pizza* pizza) {
+    // Peel off the decorators, counting their modifiers
+    while (pizza != nullptr) {
+        PizzaDecorator* decorator = pizza->asDecorator();
+        if (decorator == nullptr) {
+            break;
+        }
+        for (size_t i = 0; i < decorator->getModifierCount(); ++i) {
+            PizzaModifier modifier = decorator->getModifier(i);
+            if (modifier < PIZZA_MODIFIER_COUNT) {
+                ++modifierCounts[modifierCounts.size() - PIZZA_MODIFIER_COUNT + modifier];
+            }
+        }
+        pizza = decorator->getWrappedPizza();
+    }
+    if (pizza == nullptr) {
+        return true;
+    }
+
+    BasePizza* base = dynamic_cast<BasePizza*>(pizza);
+    if (base == nullptr) {
+        return false;
+    }
+    return base->getToppings() == nullptr || appendComponent(base->getToppings());
+}
+
+bool PriceBatch::appendComponent(const PizzaComponent* component) {
+    switch (component->getKind()) {
+        case PizzaComponent::TOPPING: {
+            const Topping* topping = static_cast<const Topping*>(component);
+            if (!appendTopping(topping->getId(), topping->getQuantity())) {
+                fixedCents.back() += topping->getPrice().getCents();
+            }
+            return true;
+        }
+        case PizzaComponent::GROUP: {
+            const ToppingGroup* group = static_cast<const ToppingGroup*>(component);
+            for (const PizzaComponent* child : group->getComponents()) {
+                if (!appendComponent(child)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PriceBatch::appendTopping(ToppingId id, uint32_t quantity) {
+    if (id < 0 || static_cast<size_t>(id) >= catalogSize) {
+        return false;
+    }
+    toppingIds.push_back(id);
+    quantities.push_back(quantity);
+    if (id > maxId) {
+        maxId = id;
+    }
+    return true;
+}
+
+void PriceBatch::sumToppings(const ToppingCatalog& catalog, Kernel kernel, std::vector<int64_t>& totals) const {
+    totals.assign(entryEnds.size(), 0);
+    const int64_t* prices = catalog.getPriceData();
+
+    if (maxId != ToppingCatalog::INVALID_ID && (prices == nullptr || static_cast<size_t>(maxId) >= catalog.size())) {
+        // Some IDs are not in this catalog: look each one up (unknown IDs cost nothing)
+        uint32_t begin = 0;
+        for (size_t i = 0; i < entryEnds.size(); ++i) {
+            for (uint32_t entry = begin; entry < entryEnds[i]; ++entry) {
+                totals[i] += catalog.getPrice(toppingIds[entry]).getCents() * static_cast<int64_t>(quantities[entry]);
+            }
+            begin = entryEnds[i];
+        }
+        return;
+    }
+
+    // One pass over every entry of the batch, summed per pizza as it goes
+    if (!entryEnds.empty()) {
+        kernelFor(kernel)(prices, toppingIds.data(), quantities.data(), entryEnds.data(), entryEnds.size(), totals.data());
+    }
+}
+
+size_t PriceBatch::size() const {
+    return entryEnds.size();
+}
+
+size_t PriceBatch::getFallbackCount() const {
+    size_t count = 0;
+    for (Pizza* pizza : fallbacks) {
+        if (pizza != nullptr) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void PriceBatch::priceInto(Money* prices, Kernel kernel) const {
+    // One snapshot for the whole batch, including the getPrice() fallbacks
+    CatalogScope scope;
+    const ToppingCatalog& catalog = scope.catalog();
+
+    std::vector<int64_t> totals;
+    sumToppings(catalog, kernel, totals);
+
+    int64_t modifierPrices[PIZZA_MODIFIER_COUNT];
+    for (size_t m = 0; m < PIZZA_MODIFIER_COUNT; ++m) {
+        modifierPrices[m] = catalog.getModifierPrice(static_cast<PizzaModifier>(m)).getCents();
+    }
+
+    for (size_t i = 0; i < entryEnds.size(); ++i) {
+        if (fallbacks[i] != nullptr) {
+            prices[i] = fallbacks[i]->getPrice();
+            continue;
+        }
+        int64_t total = totals[i] + fixedCents[i];
+        const uint32_t* counts = &modifierCounts[i * PIZZA_MODIFIER_COUNT];
+        for (size_t m = 0; m < PIZZA_MODIFIER_COUNT; ++m) {
+            total += modifierPrices[m] * counts[m];
+        }
+        prices[i] = Money::fromCents(total);
+    }
+}
+
+std::vector<Money> PriceBatch::price(Kernel kernel) const {
+    std::vector<Money> prices(size());
+    if (!prices.empty()) {
+        priceInto(prices.data(), kernel);
+    }
+    return prices;
+}
+
+void PriceBatch::priceAll(Pizza* const* pizzas, size_t count, Money* prices) {
+    PriceBatch(pizzas, count).priceInto(prices);
+}
+
+void PriceBatch::priceAll(const FrozenRecipe* const* recipes, size_t count, Money* prices) {
+    PriceBatch(recipes, count).priceInto(prices);
+}
+
+const char* PriceBatch::bestKernelName() {
+    return kernelFor(BEST) == totalsScalar ? "scalar" : "avx2";
+}
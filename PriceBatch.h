@@ -0,0 +1,100 @@
+#ifndef PRICEBATCH_H
+#define PRICEBATCH_H
+
+#include "Money.h"
+#include "ToppingCatalog.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class Pizza;
+class PizzaComponent;
+class FrozenRecipe;
+
+// Prices many pizzas in one pass, for end-of-day repricing, quotes and menu
+// refreshes. The batch flattens every pizza once into topping IDs and
+// portion counts laid out back to back, so pricing is a gather-and-sum over
+// the catalog's price table instead of a virtual getPrice() walk per pizza:
+//
+//   PriceBatch batch(pizzas.data(), pizzas.size());
+//   std::vector<Money> prices(batch.size());
+//   batch.priceInto(prices.data());
+//
+// Flattening walks every pizza's whole tree, so it costs far more than a
+// getPrice() on a pizza whose group prices are cached. A batch pays off when
+// it is priced again and again (it keeps IDs, not prices, so it follows
+// catalog changes) and for frozen recipes; for pricing live pizzas once,
+// call getPrice() on each.
+//
+// Each kernel gathers a pizza's topping prices and sums them in the same
+// loop. BEST is the AVX2 kernel (four entries per step) when the CPU reports
+// AVX2 and the scalar loop otherwise, so the choice is the same on every run
+// on a machine; pass SCALAR or AVX2 to pin it. Every kernel gives exactly
+// what getPrice() gives. Pizzas of types the batch can't flatten are priced
+// with getPrice() in the same pass, so they must outlive the batch.
+class PriceBatch {
+public:
+    enum Kernel {
+        SCALAR,  // Portable loop
+        AVX2,    // AVX2 gather kernel (scalar on CPUs without AVX2)
+        BEST     // AVX2 where the CPU has it, otherwise scalar
+    };
+
+private:
+    // Catalog toppings of all pizzas, pizza after pizza
+    std::vector<ToppingId> toppingIds;
+    std::vector<uint32_t> quantities;
+
+    // One entry per pizza
+    std::vector<uint32_t> entryEnds;      // One past the pizza's last topping entry
+    std::vector<int64_t> fixedCents;      // Toppings not in the catalog (priced when added)
+    std::vector<uint32_t> modifierCounts; // PIZZA_MODIFIER_COUNT counts per pizza
+    std::vector<Pizza*> fallbacks;        // Priced with getPrice(), or nullptr
+
+    // Largest topping ID in the batch (-1 if there is none). Every ID is at
+    // least 0 and below catalogSize.
+    ToppingId maxId;
+
+    // Size of the catalog the batch was flattened against
+    size_t catalogSize;
+
+    // Entries reserved per pizza when the batch can't count them up front
+    static const size_t TYPICAL_TOPPINGS = 8;
+
+    void reservePizzas(size_t count, size_t entries);
+
+    // Start a new pizza entry
+    void beginPizza();
+
+    // Flatten a pizza; returns false if it contains types the batch can't read
+    bool appendPizza(Pizza* pizza);
+    bool appendComponent(const PizzaComponent* component);
+    // Add a catalog topping; returns false if id isn't in the catalog
+    bool appendTopping(ToppingId id, uint32_t quantity);
+
+    // Sum of the catalog toppings of every pizza, one total per pizza
+    void sumToppings(const ToppingCatalog& catalog, Kernel kernel, std::vector<int64_t>& totals) const;
+
+public:
+    PriceBatch(Pizza* const* pizzas, size_t count);
+    PriceBatch(const FrozenRecipe* const* recipes, size_t count);
+
+    // Number of pizzas
+    size_t size() const;
+
+    // Number of pizzas priced with getPrice() because they couldn't be flattened
+    size_t getFallbackCount() const;
+
+    // Write size() prices, in input order, using the active catalog
+    void priceInto(Money* prices, Kernel kernel = BEST) const;
+    std::vector<Money> price(Kernel kernel = BEST) const;
+
+    // Flatten and price in one call (see above for when that is worth it)
+    static void priceAll(Pizza* const* pizzas, size_t count, Money* prices);
+    static void priceAll(const FrozenRecipe* const* recipes, size_t count, Money* prices);
+
+    // Name of the kernel BEST runs on this CPU ("avx2" or "scalar")
+    static const char* bestKernelName();
+};
+
+#endif
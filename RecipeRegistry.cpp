@@ -0,0 +1,147 @@
+#include "RecipeRegistry.h"
+#include "ToppingCatalog.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    std::string trim(const std::string& text) {
+        size_t start = text.find_first_not_of(" \t\r\n");
+        if (start == std::string::npos) {
+            return "";
+        }
+        size_t end = text.find_last_not_of(" \t\r\n");
+        return text.substr(start, end - start + 1);
+    }
+
+    // Split "Pepperoni x3" into the topping name and its portions (1 if no
+    // count is given, 0 if the count is out of range)
+    unsigned splitQuantity(std::string& component) {
+        size_t marker = component.rfind(" x");
+        if (marker == std::string::npos || marker + 2 == component.size() ||
+            component.find_first_not_of("0123456789", marker + 2) != std::string::npos) {
+            return 1;
+        }
+        unsigned quantity = 0;
+        for (size_t i = marker + 2; i < component.size(); ++i) {
+            quantity = quantity * 10 + static_cast<unsigned>(component[i] - '0');
+            if (quantity > 999) {
+                return 0;
+            }
+        }
+        component = trim(component.substr(0, marker));
+        return quantity;
+    }
+}
+
+const char* const RecipeRegistry::DEFAULT_RECIPES =
+    "Base: Dough, Tomato Sauce, Cheese\n"
+    "Pepperoni: @Base, Pepperoni\n"
+    "Vegetarian: @Base, Mushrooms, Green Peppers, Onions\n"
+    "Meat Lovers: @Pepperoni, Beef Sausage, Salami\n"
+    "Vegetarian Deluxe: @Vegetarian, Feta Cheese, Olives\n";
+
+RecipeRegistry::RecipeSet* RecipeRegistry::parse(const std::string& text, const std::string& source) {
+    std::unique_ptr<RecipeSet> recipes(new RecipeSet());
+    CatalogSnapshot catalog = ToppingCatalog::current();
+
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        size_t colon = line.find(':');
+        std::string recipeName = colon == std::string::npos ? "" : trim(line.substr(0, colon));
+        if (recipeName.empty() || recipes->prototypes.count(recipeName) != 0) {
+            std::cerr << "Error: Invalid recipe name on line " << lineNumber
+                      << " of '" << source << "'." << std::endl;
+            return nullptr;
+        }
+
+        // Build the prototype; nested recipes share the earlier prototypes
+        std::unique_ptr<ToppingGroup> prototype(new ToppingGroup(recipeName));
+        std::istringstream components(line.substr(colon + 1));
+        std::string component;
+        while (std::getline(components, component, ',')) {
+            component = trim(component);
+            if (!component.empty() && component[0] == '@') {
+                auto nested = recipes->prototypes.find(trim(component.substr(1)));
+                if (nested != recipes->prototypes.end()) {
+                    prototype->addComponent(new ToppingGroup(*nested->second));
+                    continue;
+                }
+            } else {
+                std::string toppingName = component;
+                unsigned quantity = splitQuantity(toppingName);
+                ToppingId id = catalog->findId(toppingName);
+                if (id != ToppingCatalog::INVALID_ID && quantity != 0) {
+                    prototype->addTopping(id, quantity);
+                    continue;
+                }
+            }
+            std::cerr << "Error: Unknown component '" << component << "' on line " << lineNumber
+                      << " of '" << source << "'." << std::endl;
+            return nullptr;
+        }
+
+        recipes->names.push_back(recipeName);
+        recipes->prototypes[recipeName].reset(prototype.release());
+    }
+    return recipes.release();
+}
+
+std::shared_ptr<const RecipeRegistry::RecipeSet>& RecipeRegistry::published() {
+    static std::shared_ptr<const RecipeSet> recipes(parse(DEFAULT_RECIPES, "default recipes"));
+    return recipes;
+}
+
+void RecipeRegistry::publish(RecipeSet* recipes) {
+    std::shared_ptr<const RecipeSet> next(recipes);
+    std::atomic_store(&published(), next);
+}
+
+bool RecipeRegistry::loadFromFile(const std::string& path) {
+    std::ifstream file(path.c_str());
+    if (!file) {
+        std::cerr << "Error: Could not open recipe file '" << path << "'." << std::endl;
+        return false;
+    }
+
+    // Parse everything first so a bad file never replaces good recipes
+    std::stringstream text;
+    text << file.rdbuf();
+    RecipeSet* recipes = parse(text.str(), path);
+    if (recipes == nullptr) {
+        return false;
+    }
+    publish(recipes);
+    return true;
+}
+
+void RecipeRegistry::resetToDefaults() {
+    publish(parse(DEFAULT_RECIPES, "default recipes"));
+}
+
+ToppingGroup* RecipeRegistry::instantiate(const std::string& recipeName, MemoryResource& memoryResource) {
+    std::shared_ptr<const RecipeSet> recipes = std::atomic_load(&published());
+    auto found = recipes->prototypes.find(recipeName);
+    if (found == recipes->prototypes.end()) {
+        return nullptr;
+    }
+    return new (memoryResource) ToppingGroup(*found->second, memoryResource);
+}
+
+bool RecipeRegistry::contains(const std::string& recipeName) {
+    std::shared_ptr<const RecipeSet> recipes = std::atomic_load(&published());
+    return recipes->prototypes.count(recipeName) != 0;
+}
+
+std::vector<std::string> RecipeRegistry::getRecipeNames() {
+    std::shared_ptr<const RecipeSet> recipes = std::atomic_load(&published());
+    return recipes->names;
+}
@@ -0,0 +1,69 @@
+#ifndef RECIPEREGISTRY_H
+#define RECIPEREGISTRY_H
+
+#include "ToppingGroup.h"
+#include "MemoryResource.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+
+// Named pizza recipes, each built once into an immutable prototype group.
+// Instances share the prototype's components (copy on write), so handing out
+// a recipe costs the same whatever its depth, and a new recipe only needs a
+// line in the recipe file.
+//
+// Recipe file format, one recipe per line ('#' starts a comment):
+//   Name: component, component, ...
+// A component is a topping name from the catalog, optionally followed by a
+// portion count ("Pepperoni x2"), or @Name for a recipe defined on an
+// earlier line, which is nested as a group:
+//   Base: Dough, Tomato Sauce, Cheese
+//   Pepperoni: @Base, Pepperoni
+//   Double Pepperoni: @Base, Pepperoni x2
+//
+// Like the catalog, the registry is replaced as a whole: a reload publishes
+// a new set of prototypes, and instances of the old ones stay valid.
+class RecipeRegistry {
+private:
+    // One published set of prototypes (never changed once published)
+    struct RecipeSet {
+        std::map<std::string, std::unique_ptr<const ToppingGroup> > prototypes;
+        std::vector<std::string> names;  // In file order
+    };
+
+    // Parse recipe text into a new set; returns nullptr (after reporting the
+    // line) if it can't be parsed
+    static RecipeSet* parse(const std::string& text, const std::string& source);
+
+    // The published set (built from the default recipes on first use).
+    // Read and replaced with the atomic shared_ptr functions.
+    static std::shared_ptr<const RecipeSet>& published();
+
+    // Swap in a new set (instances of the old prototypes keep their components)
+    static void publish(RecipeSet* recipes);
+
+public:
+    // Recipes used until a file is loaded (same as recipes.txt)
+    static const char* const DEFAULT_RECIPES;
+
+    // Load recipes from a file and publish them. Returns false (and keeps
+    // the current recipes) if the file can't be read or parsed.
+    static bool loadFromFile(const std::string& path);
+
+    // Go back to the default recipes
+    static void resetToDefaults();
+
+    // New group for the named recipe, sharing the prototype's components and
+    // allocated from memoryResource. Returns nullptr for an unknown recipe.
+    static ToppingGroup* instantiate(const std::string& recipeName,
+                                     MemoryResource& memoryResource = MemoryResource::heap());
+
+    // Check if a recipe exists
+    static bool contains(const std::string& recipeName);
+
+    // Names of all recipes, in the order they were defined
+    static std::vector<std::string> getRecipeNames();
+};
+
+#endif
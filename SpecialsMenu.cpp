@@ -1,12 +1,16 @@
 #include "SpecialsMenu.h"
-#include <iostream>
+#include "PizzaName.h"
 
 SpecialsMenu::SpecialsMenu(const std::string& name): menuName(name){
 }
 
 void SpecialsMenu::notifyObservers(const std::string& message){
-    std::cout << "\nSpecials Menu Notification" << std::endl;
-    std::cout << "Broadcasting from " << menuName << ": " << message << std::endl;
+    // Printed before the observers so their output follows it
+    {
+        Document document(*outputSink);
+        document << "\nSpecials Menu Notification\n";
+        document << "Broadcasting from " << menuName << ": " << message << '\n';
+    }
     
     for(Observer* observer : observers){
 
@@ -15,7 +19,8 @@ void SpecialsMenu::notifyObservers(const std::string& message){
         }
     }
 
-    std::cout << "Special notification sent to " << observers.size() << " observers." << std::endl;
+    Document document(*outputSink);
+    document << "Special notification sent to " << observers.size() << " observers.\n";
 }
 
 void SpecialsMenu::addSpecialOffer(Pizza* pizza, const std::string& specialDescription){
@@ -24,9 +29,23 @@ void SpecialsMenu::addSpecialOffer(Pizza* pizza, const std::string& specialDescr
 
         specialOffers[pizza] = specialDescription;
         
-        std::string message = "New special offer: " + pizza->getName() + 
-                              " - " + specialDescription + 
-                              " (R" + std::to_string(pizza->getPrice()) + ")";
+        // Size the message up front so it is built with a single allocation
+        static const char prefix[] = "New special offer: ";
+        static const char separator[] = " - ";
+        static const char priceOpen[] = " (R";
+        static const char priceClose[] = ")";
+        std::string price = pizza->getPrice().toString();
+        std::string message;
+        message.reserve(sizeof(prefix) - 1 + nameLength(*pizza) + sizeof(separator) - 1 +
+                        specialDescription.size() + sizeof(priceOpen) - 1 + price.size() +
+                        sizeof(priceClose) - 1);
+        message += prefix;
+        appendName(message, *pizza);
+        message += separator;
+        message += specialDescription;
+        message += priceOpen;
+        message += price;
+        message += priceClose;
 
         notifyObservers(message);
     }
@@ -34,14 +53,21 @@ void SpecialsMenu::addSpecialOffer(Pizza* pizza, const std::string& specialDescr
 
 void SpecialsMenu::removeSpecialOffer(Pizza* pizza){
     if(pizza != nullptr){
-        std::string pizzaName = pizza->getName();
+        static const char prefix[] = "Special has ended: ";
+        static const char middle[] = " special offer (";
+        static const char suffix[] = ") has ended.";
         std::string offer = getSpecialOffer(pizza);
+        std::string message;
+        message.reserve(sizeof(prefix) - 1 + nameLength(*pizza) + sizeof(middle) - 1 +
+                        offer.size() + sizeof(suffix) - 1);
+        message += prefix;
+        appendName(message, *pizza);
+        message += middle;
+        message += offer;
+        message += suffix;
         
         specialOffers.erase(pizza);
         removePizza(pizza);
-        
-        std::string message = "Special has ended: " + pizzaName + 
-                              " special offer (" + offer + ") has ended.";
 
         notifyObservers(message);
     }
@@ -73,20 +99,40 @@ std::string SpecialsMenu::getSpecialOffer(Pizza* pizza) const{
     return "No special offer";
 }
 
-void SpecialsMenu::displaySpecialsMenu() const{
-    std::cout << "\n=== " << menuName << " ===" << std::endl;
+void SpecialsMenu::displaySpecialsMenu(OutputSink& sink) const{
+    Document document(sink);
+    document << "\n=== " << menuName << " ===\n";
 
     if(pizzas.empty()){
-        std::cout << "No special offers currently available." << std::endl;
+        document << "No special offers currently available.\n";
     } 
     
     else{
         for (size_t i = 0; i < pizzas.size(); ++i) {
-            std::string offer = getSpecialOffer(pizzas[i]);
-            std::cout << (i + 1) << ". " << pizzas[i]->getName() 
+            std::string offer = getSpecialOffer(pizzas[i].get());
+            document << (i + 1) << ". " << nameOf(*pizzas[i]) 
                       << " - R" << pizzas[i]->getPrice() 
-                      << " [" << offer << "]" << std::endl;
+                      << " [" << offer << "]\n";
+        }
+    }
+    document << "==========================\n";
+}
+
+int SpecialsMenu::loadFromImage(const CatalogImage& image){
+    int loaded = 0;
+
+    for(uint32_t i = 0; i < image.getMenuEntryCount(); ++i){
+        if(!image.isSpecial(i)){
+            continue;
+        }
+
+        Pizza* pizza = image.buildMenuPizza(i);
+        if(pizza != nullptr){
+            Menus::addPizza(pizza);
+            specialOffers[pizza] = image.getMenuDescription(i).str();
+            ++loaded;
         }
     }
-    std::cout << "==========================" << std::endl;
-}
\ No newline at end of file
+
+    return loaded;
+}
\ No newline at end of file
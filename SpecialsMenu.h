@@ -1,6 +1,7 @@
 #ifndef SPECIALSMENU_H
 #define SPECIALSMENU_H
 #include "Menus.h"
+#include "CatalogImage.h"
 #include <string>
 #include <map>
 
@@ -11,6 +12,8 @@ private:
 public:
     SpecialsMenu(const std::string& name = "Specials Menu");
     virtual ~SpecialsMenu() = default;
+    SpecialsMenu(SpecialsMenu&& other) = default;
+    SpecialsMenu& operator=(SpecialsMenu&& other) = default;
     
     void notifyObservers(const std::string& message) override;
     void addSpecialOffer(Pizza* pizza, const std::string& specialDescription);
@@ -20,7 +23,10 @@ public:
     
     std::string getMenuName() const;
     std::string getSpecialOffer(Pizza* pizza) const;
-    void displaySpecialsMenu() const;
+    void displaySpecialsMenu(OutputSink& sink = OutputSink::console()) const;
+    
+    // Add the image's special offers without broadcasting, returns how many were added
+    int loadFromImage(const CatalogImage& image);
 };
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file
@@ -0,0 +1,141 @@
+#ifndef STATICDECORATOR_H
+#define STATICDECORATOR_H
+
+#include "PizzaDecorator.h"
+#include "StaticRecipe.h"
+#include "PizzaName.h"
+#include <string>
+#include <cstddef>
+
+// Decorator whose add-ons are fixed at compile time, for code that knows
+// them up front (the create*Pizza(extraCheese, stuffedCrust) combinations,
+// menu specials):
+//
+//   Pizza* pizza = new StaticDecorator<BasePizza, EXTRA_CHEESE, STUFFED_CRUST>(base);
+//
+// The inner pizza's concrete type is part of the decorator type, so pricing
+// and naming call it without virtual dispatch, the modifier prices are an
+// unrolled sum and the " + Extra Cheese + Stuffed Crust" suffix is a static
+// string. It is still a PizzaDecorator with the same modifier set, so it can
+// be wrapped, cloned, frozen and inspected like any runtime decorator. If
+// modifiers are added at run time it falls back to the runtime pass.
+
+namespace StaticDecoratorDetail {
+    // The modifiers of a StaticDecorator, innermost first. Provides
+    // nameLength()/nameAt() for StaticName, the catalog price and the
+    // fingerprint.
+    template <PizzaModifier... Modifiers>
+    struct ModifierList;
+
+    template <>
+    struct ModifierList<> {
+        static constexpr Money defaultPrice() { return Money(); }
+        static Money priceWith(const ToppingCatalog&) { return Money(); }
+        static constexpr size_t nameLength() { return 0; }
+        static constexpr char nameAt(size_t) { return '\0'; }
+        static constexpr PizzaFingerprint fingerprint() { return PizzaFingerprint(); }
+    };
+
+    template <PizzaModifier First, PizzaModifier... Rest>
+    struct ModifierList<First, Rest...> {
+        typedef ModifierList<Rest...> Tail;
+
+        static constexpr const char* name() {
+            return ToppingCatalog::DEFAULT_MODIFIERS[First].name;
+        }
+        static constexpr size_t ownLength() {
+            return 3 + StaticRecipeDetail::length(name());
+        }
+
+        static constexpr Money defaultPrice() {
+            return Money::fromCents(ToppingCatalog::DEFAULT_MODIFIERS[First].cents) + Tail::defaultPrice();
+        }
+        static Money priceWith(const ToppingCatalog& catalog) {
+            return catalog.getModifierPrice(First) + Tail::priceWith(catalog);
+        }
+        static constexpr size_t nameLength() {
+            return ownLength() + Tail::nameLength();
+        }
+        static constexpr char nameAt(size_t index) {
+            return index < 3 ? " + "[index]
+                 : index < ownLength() ? name()[index - 3]
+                 : Tail::nameAt(index - ownLength());
+        }
+        static constexpr PizzaFingerprint fingerprint() {
+            return PizzaFingerprint::ofModifier(First) + Tail::fingerprint();
+        }
+    };
+}
+
+template <typename Inner, PizzaModifier... Modifiers>
+class StaticDecorator : public PizzaDecorator {
+private:
+    static_assert(sizeof...(Modifiers) >= 1 && sizeof...(Modifiers) <= PizzaDecorator::MAX_MODIFIERS,
+                  "StaticDecorator needs between one and MAX_MODIFIERS modifiers");
+
+    typedef StaticDecoratorDetail::ModifierList<Modifiers...> List;
+
+    // True while the set holds only the compile-time modifiers
+    bool isStatic() const {
+        return modifierCount == sizeof...(Modifiers);
+    }
+
+public:
+    explicit StaticDecorator(Inner* pizzaToDecorate) : PizzaDecorator(pizzaToDecorate) {
+        const PizzaModifier list[] = {Modifiers...};
+        for (PizzaModifier modifier : list) {
+            addModifier(modifier);
+        }
+    }
+
+    // Price of the add-ons at the default modifier prices
+    static constexpr Money defaultModifierPrice() { return List::defaultPrice(); }
+
+    // " + Extra Cheese + ..." as a static string
+    static constexpr const char* suffix() { return StaticName<List>::value; }
+    static constexpr size_t suffixLength() { return List::nameLength(); }
+
+    Inner* getInnerPizza() const {
+        return static_cast<Inner*>(pizza);
+    }
+
+    Money getPrice() override {
+        if (!isStatic()) {
+            return PizzaDecorator::getPrice();
+        }
+        CatalogScope scope;
+        Money price = pizza != nullptr ? getInnerPizza()->Inner::getPrice() : Money();
+        return price + List::priceWith(scope.catalog());
+    }
+
+    PizzaFingerprint getFingerprint() override {
+        if (!isStatic()) {
+            return PizzaDecorator::getFingerprint();
+        }
+        PizzaFingerprint inner = pizza != nullptr ? getInnerPizza()->Inner::getFingerprint() : PizzaFingerprint();
+        return inner + List::fingerprint();
+    }
+
+    void writeName(NameWriter& out) override {
+        if (!isStatic()) {
+            PizzaDecorator::writeName(out);
+            return;
+        }
+        if (pizza != nullptr) {
+            getInnerPizza()->Inner::writeName(out);
+        } else {
+            out.append("Unknown Pizza");
+        }
+        out.append(suffix(), suffixLength());
+    }
+
+    Pizza* cloneInto(MemoryResource& resource) const override {
+        if (!isStatic()) {
+            return PizzaDecorator::cloneInto(resource);
+        }
+        Inner* copy = pizza != nullptr ? static_cast<Inner*>(pizza->cloneInto(resource)) : nullptr;
+        return new (resource) StaticDecorator<Inner, Modifiers...>(copy);
+    }
+};
+
+#endif
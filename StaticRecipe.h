@@ -0,0 +1,296 @@
+#ifndef STATICRECIPE_H
+#define STATICRECIPE_H
+
+#include "Pizza.h"
+#include "Money.h"
+#include "ToppingCatalog.h"
+#include "ExtraCheese.h"
+#include "StuffedCrust.h"
+#include "PizzaName.h"
+#include "PizzaFingerprint.h"
+#include <string>
+#include <cstddef>
+
+// Recipes and decorator stacks declared as types, for pizzas that don't
+// change between releases. The compiler works out the price at the default
+// catalog prices, the topping count and the display name, so none of it is
+// computed at run time:
+//
+//   struct MargheritaName { static constexpr const char* value() { return "Margherita"; } };
+//   typedef StaticGroup<MargheritaName, StaticBase, StaticTopping<StaticToppings::OLIVES> > StaticMargherita;
+//   static_assert(StaticMargherita::defaultPrice() == Money::fromRands(45), "");
+//
+// StaticPizza<Recipe> wraps a recipe in the runtime Pizza interface. It uses
+// the compile-time price while the catalog still has its default prices, and
+// otherwise adds up the recipe's toppings (an unrolled sum, not a tree walk).
+//
+// Every node type provides:
+//   static constexpr Money defaultPrice();
+//   static Money priceWith(const ToppingCatalog& catalog);
+//   static constexpr size_t nameLength();
+//   static constexpr char nameAt(size_t index);
+//   static constexpr size_t toppingCount();
+//   static constexpr PizzaFingerprint fingerprint();
+
+namespace StaticRecipeDetail {
+    constexpr size_t length(const char* text) {
+        return *text == '\0' ? 0 : 1 + length(text + 1);
+    }
+
+    constexpr bool equal(const char* first, const char* second) {
+        return *first == *second && (*first == '\0' || equal(first + 1, second + 1));
+    }
+
+    // Compile-time list of indices 0 .. N-1, used to expand a name into characters
+    template <size_t... Indices>
+    struct IndexList {};
+
+    template <size_t N, size_t... Indices>
+    struct MakeIndexList : MakeIndexList<N - 1, N - 1, Indices...> {};
+
+    template <size_t... Indices>
+    struct MakeIndexList<0, Indices...> {
+        typedef IndexList<Indices...> type;
+    };
+}
+
+// IDs of the predefined toppings (their position in ToppingCatalog::DEFAULT_TOPPINGS)
+namespace StaticToppings {
+    constexpr ToppingId DOUGH = 0;
+    constexpr ToppingId TOMATO_SAUCE = 1;
+    constexpr ToppingId CHEESE = 2;
+    constexpr ToppingId PEPPERONI = 3;
+    constexpr ToppingId MUSHROOMS = 4;
+    constexpr ToppingId GREEN_PEPPERS = 5;
+    constexpr ToppingId ONIONS = 6;
+    constexpr ToppingId BEEF_SAUSAGE = 7;
+    constexpr ToppingId SALAMI = 8;
+    constexpr ToppingId FETA_CHEESE = 9;
+    constexpr ToppingId OLIVES = 10;
+
+    static_assert(StaticRecipeDetail::equal(ToppingCatalog::DEFAULT_TOPPINGS[DOUGH].name, "Dough") &&
+                  StaticRecipeDetail::equal(ToppingCatalog::DEFAULT_TOPPINGS[OLIVES].name, "Olives"),
+                  "StaticToppings IDs must follow ToppingCatalog::DEFAULT_TOPPINGS");
+}
+
+// A predefined topping
+template <ToppingId Id>
+struct StaticTopping {
+    static_assert(Id >= 0 && static_cast<size_t>(Id) < ToppingCatalog::DEFAULT_TOPPING_COUNT,
+                  "StaticTopping needs a predefined topping");
+
+    static constexpr Money defaultPrice() {
+        return Money::fromCents(ToppingCatalog::DEFAULT_TOPPINGS[Id].cents);
+    }
+    static Money priceWith(const ToppingCatalog& catalog) {
+        return catalog.getPrice(Id);
+    }
+    static constexpr size_t nameLength() {
+        return StaticRecipeDetail::length(ToppingCatalog::DEFAULT_TOPPINGS[Id].name);
+    }
+    static constexpr char nameAt(size_t index) {
+        return ToppingCatalog::DEFAULT_TOPPINGS[Id].name[index];
+    }
+    static constexpr size_t toppingCount() {
+        return 1;
+    }
+    static constexpr PizzaFingerprint fingerprint() {
+        return PizzaFingerprint::ofTopping(ToppingCatalog::DEFAULT_TOPPINGS[Id].name, nameLength());
+    }
+};
+
+// Components of a group, named "First, Second, ..."
+template <typename... Components>
+struct StaticComponents;
+
+template <>
+struct StaticComponents<> {
+    static constexpr Money defaultPrice() { return Money(); }
+    static Money priceWith(const ToppingCatalog&) { return Money(); }
+    static constexpr size_t nameLength() { return 0; }
+    static constexpr char nameAt(size_t) { return '\0'; }
+    static constexpr size_t toppingCount() { return 0; }
+    static constexpr PizzaFingerprint fingerprint() { return PizzaFingerprint(); }
+};
+
+template <typename First, typename... Rest>
+struct StaticComponents<First, Rest...> {
+    typedef StaticComponents<Rest...> Tail;
+
+    static constexpr Money defaultPrice() {
+        return First::defaultPrice() + Tail::defaultPrice();
+    }
+    static Money priceWith(const ToppingCatalog& catalog) {
+        return First::priceWith(catalog) + Tail::priceWith(catalog);
+    }
+    static constexpr size_t nameLength() {
+        return First::nameLength() + (sizeof...(Rest) == 0 ? 0 : 2 + Tail::nameLength());
+    }
+    static constexpr char nameAt(size_t index) {
+        return index < First::nameLength() ? First::nameAt(index)
+             : index < First::nameLength() + 2 ? ", "[index - First::nameLength()]
+             : Tail::nameAt(index - First::nameLength() - 2);
+    }
+    static constexpr size_t toppingCount() {
+        return First::toppingCount() + Tail::toppingCount();
+    }
+    static constexpr PizzaFingerprint fingerprint() {
+        return First::fingerprint() + Tail::fingerprint();
+    }
+};
+
+// A named group, rendered like ToppingGroup: "Name (First, Second, ...)".
+// Name is a type with a static constexpr value() returning the group name.
+template <typename Name, typename... Components>
+struct StaticGroup {
+    typedef StaticComponents<Components...> List;
+
+    static constexpr size_t groupNameLength() {
+        return StaticRecipeDetail::length(Name::value());
+    }
+
+    static constexpr Money defaultPrice() {
+        return List::defaultPrice();
+    }
+    static Money priceWith(const ToppingCatalog& catalog) {
+        return List::priceWith(catalog);
+    }
+    static constexpr size_t nameLength() {
+        return groupNameLength() + (sizeof...(Components) == 0 ? 0 : 2 + List::nameLength() + 1);
+    }
+    static constexpr char nameAt(size_t index) {
+        return index < groupNameLength() ? Name::value()[index]
+             : index < groupNameLength() + 2 ? " ("[index - groupNameLength()]
+             : index < groupNameLength() + 2 + List::nameLength() ? List::nameAt(index - groupNameLength() - 2)
+             : ')';
+    }
+    static constexpr size_t toppingCount() {
+        return List::toppingCount();
+    }
+    static constexpr PizzaFingerprint fingerprint() {
+        return List::fingerprint();
+    }
+};
+
+// Decorators, rendered and priced like ExtraCheese and StuffedCrust
+template <typename Inner>
+struct WithExtraCheese {
+    static constexpr Money defaultPrice() {
+        return Inner::defaultPrice() + ExtraCheese::getExtraCheesePrice();
+    }
+    static Money priceWith(const ToppingCatalog& catalog) {
+        return Inner::priceWith(catalog) + catalog.getModifierPrice(EXTRA_CHEESE);
+    }
+    static constexpr size_t nameLength() {
+        return Inner::nameLength() + StaticRecipeDetail::length(" + Extra Cheese");
+    }
+    static constexpr char nameAt(size_t index) {
+        return index < Inner::nameLength() ? Inner::nameAt(index) : " + Extra Cheese"[index - Inner::nameLength()];
+    }
+    static constexpr size_t toppingCount() {
+        return Inner::toppingCount();
+    }
+    static constexpr PizzaFingerprint fingerprint() {
+        return Inner::fingerprint() + PizzaFingerprint::ofModifier(EXTRA_CHEESE);
+    }
+};
+
+template <typename Inner>
+struct WithStuffedCrust {
+    static constexpr Money defaultPrice() {
+        return Inner::defaultPrice() + StuffedCrust::getStuffedCrustPrice();
+    }
+    static Money priceWith(const ToppingCatalog& catalog) {
+        return Inner::priceWith(catalog) + catalog.getModifierPrice(STUFFED_CRUST);
+    }
+    static constexpr size_t nameLength() {
+        return Inner::nameLength() + StaticRecipeDetail::length(" + Stuffed Crust");
+    }
+    static constexpr char nameAt(size_t index) {
+        return index < Inner::nameLength() ? Inner::nameAt(index) : " + Stuffed Crust"[index - Inner::nameLength()];
+    }
+    static constexpr size_t toppingCount() {
+        return Inner::toppingCount();
+    }
+    static constexpr PizzaFingerprint fingerprint() {
+        return Inner::fingerprint() + PizzaFingerprint::ofModifier(STUFFED_CRUST);
+    }
+};
+
+// The full display name of a recipe as a static character array
+template <typename Recipe,
+          typename Indices = typename StaticRecipeDetail::MakeIndexList<Recipe::nameLength()>::type>
+struct StaticName;
+
+template <typename Recipe, size_t... Indices>
+struct StaticName<Recipe, StaticRecipeDetail::IndexList<Indices...> > {
+    static constexpr char value[sizeof...(Indices) + 1] = {Recipe::nameAt(Indices)..., '\0'};
+};
+
+template <typename Recipe, size_t... Indices>
+constexpr char StaticName<Recipe, StaticRecipeDetail::IndexList<Indices...> >::value[sizeof...(Indices) + 1];
+
+// Runtime Pizza for a compile-time recipe (holds no data of its own)
+template <typename Recipe>
+class StaticPizza : public Pizza {
+public:
+    static constexpr Money defaultPrice() { return Recipe::defaultPrice(); }
+    static constexpr const char* name() { return StaticName<Recipe>::value; }
+    static constexpr size_t nameLength() { return Recipe::nameLength(); }
+
+    Money getPrice() override {
+        CatalogScope scope;
+        const ToppingCatalog& catalog = scope.catalog();
+        return catalog.hasDefaultPrices() ? Recipe::defaultPrice() : Recipe::priceWith(catalog);
+    }
+
+    std::string getName() override {
+        return std::string(name(), nameLength());
+    }
+
+    void writeName(NameWriter& out) override {
+        out.append(name(), nameLength());
+    }
+
+    PizzaFingerprint getFingerprint() override {
+        return Recipe::fingerprint();
+    }
+
+    Pizza* cloneInto(MemoryResource& resource) const override {
+        return new (resource) StaticPizza<Recipe>();
+    }
+};
+
+// The flagship recipes (same as the default RecipeRegistry recipes)
+struct StaticBaseName { static constexpr const char* value() { return "Base"; } };
+struct StaticPepperoniName { static constexpr const char* value() { return "Pepperoni"; } };
+struct StaticVegetarianName { static constexpr const char* value() { return "Vegetarian"; } };
+struct StaticMeatLoversName { static constexpr const char* value() { return "Meat Lovers"; } };
+struct StaticVegetarianDeluxeName { static constexpr const char* value() { return "Vegetarian Deluxe"; } };
+
+typedef StaticGroup<StaticBaseName,
+                    StaticTopping<StaticToppings::DOUGH>,
+                    StaticTopping<StaticToppings::TOMATO_SAUCE>,
+                    StaticTopping<StaticToppings::CHEESE> > StaticBase;
+
+typedef StaticGroup<StaticPepperoniName,
+                    StaticBase,
+                    StaticTopping<StaticToppings::PEPPERONI> > StaticPepperoni;
+
+typedef StaticGroup<StaticVegetarianName,
+                    StaticBase,
+                    StaticTopping<StaticToppings::MUSHROOMS>,
+                    StaticTopping<StaticToppings::GREEN_PEPPERS>,
+                    StaticTopping<StaticToppings::ONIONS> > StaticVegetarian;
+
+typedef StaticGroup<StaticMeatLoversName,
+                    StaticPepperoni,
+                    StaticTopping<StaticToppings::BEEF_SAUSAGE>,
+                    StaticTopping<StaticToppings::SALAMI> > StaticMeatLovers;
+
+typedef StaticGroup<StaticVegetarianDeluxeName,
+                    StaticVegetarian,
+                    StaticTopping<StaticToppings::FETA_CHEESE>,
+                    StaticTopping<StaticToppings::OLIVES> > StaticVegetarianDeluxe;
+
+#endif
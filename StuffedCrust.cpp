@@ -1,29 +1,12 @@
 #include "StuffedCrust.h"
-#include <iostream>
 
-const double StuffedCrust::STUFFED_CRUST_PRICE = 20.00;
+constexpr Money StuffedCrust::STUFFED_CRUST_PRICE;
 
-StuffedCrust::StuffedCrust(Pizza* pizzaToDecorate) : PizzaDecorator(pizzaToDecorate) {
+StuffedCrust::StuffedCrust(Pizza* pizzaToDecorate) : PizzaDecorator(pizzaToDecorate, STUFFED_CRUST) {
 }
 
-double StuffedCrust::getPrice() {
-    return PizzaDecorator::getPrice() + STUFFED_CRUST_PRICE;
-}
-
-std::string StuffedCrust::getName() {
-    return PizzaDecorator::getName() + " + Stuffed Crust";
-}
-
-void StuffedCrust::printPizza() {
-    std::cout << "Pizza with Stuffed Crust: " << getName() << std::endl;
-    std::cout << "Price: R" << getPrice() << std::endl;
-}
-
-double StuffedCrust::getStuffedCrustPrice() {
-    return STUFFED_CRUST_PRICE;
-}
-
-Pizza* StuffedCrust::clone() const {
-    Pizza* clonedWrappedPizza = pizza->clone();
-    return new StuffedCrust(clonedWrappedPizza);
+Pizza* StuffedCrust::cloneInto(MemoryResource& resource) const {
+    StuffedCrust* copy = new (resource) StuffedCrust(owned != nullptr ? owned->cloneInto(resource) : nullptr);
+    copy->copyModifiers(*this);
+    return copy;
 }
\ No newline at end of file
@@ -4,23 +4,23 @@
 #include "PizzaDecorator.h"
 #include <string>
 
-// Concrete decorator for adding stuffed crust to a pizza
+// Concrete decorator for adding stuffed crust to a pizza (adds STUFFED_CRUST
+// to the pizza's modifier set)
 class StuffedCrust : public PizzaDecorator {
 private:
-    static const double STUFFED_CRUST_PRICE;
+    static constexpr Money STUFFED_CRUST_PRICE =
+        Money::fromCents(ToppingCatalog::DEFAULT_MODIFIERS[STUFFED_CRUST].cents);
 
 public:
     StuffedCrust(Pizza* pizzaToDecorate);
     virtual ~StuffedCrust() = default;
     
-    virtual double getPrice() override;
-    virtual std::string getName() override;
-    virtual void printPizza() override;
+    // Clones stay StuffedCrust objects
+    virtual Pizza* cloneInto(MemoryResource& resource) const override;
     
-    // Static method to get the stuffed crust price
-    static double getStuffedCrustPrice();
-
-    Pizza* clone() const override;
+    // Static method to get the default stuffed crust price (usable at compile
+    // time; the active catalog may reprice it)
+    static constexpr Money getStuffedCrustPrice() { return STUFFED_CRUST_PRICE; }
 };
 
-#endif
\ No newline at end of file
+#endif
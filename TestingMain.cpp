@@ -1,5 +1,12 @@
 #include "PizzaComponent.h"
 #include "Topping.h"
+#include "ToppingCatalog.h"
+#include "CatalogImage.h"
+#include "PizzaName.h"
+#include "FrozenRecipe.h"
+#include "RecipeRegistry.h"
+#include "StaticRecipe.h"
+#include "StaticDecorator.h"
 #include "ToppingGroup.h"
 #include "Pizza.h"
 #include "BasePizza.h"
@@ -7,6 +14,10 @@
 #include "ExtraCheese.h"
 #include "StuffedCrust.h"
 #include "PizzaOrders.h"
+#include "PizzaHandle.h"
+#include "PriceBatch.h"
+#include "OutputSink.h"
+#include "OrderPool.h"
 #include "Observer.h"
 #include "Menus.h"
 #include "PizzaMenu.h"
@@ -14,10 +25,20 @@
 #include "Customer.h"
 #include "Website.h"
 #include "ConcreteStates.h"
+#include "OrderLifecycle.h"
+#include "OrderRegistry.h"
 #include "DiscountStrategy.h"
 #include "ConcreteStrategy.h"
 #include <iostream>
 #include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include <algorithm>
 
 using namespace std;
 
@@ -140,18 +161,18 @@ void testDecoratorPricing() {
     simpleToppings->addComponent(new Topping("Cheese"));
     
     Pizza* simplePizza = new BasePizza(simpleToppings);
-    double basePrice = simplePizza->getPrice();
+    Money basePrice = simplePizza->getPrice();
     
     cout << "Base Pizza Price: R" << basePrice << endl;
     
     // Test individual decorators
     Pizza* withCheese = new ExtraCheese(simplePizza);
-    double cheesePrice = withCheese->getPrice();
+    Money cheesePrice = withCheese->getPrice();
     cout << "With Extra Cheese: R" << cheesePrice << endl;
     cout << "Price increase: R" << (cheesePrice - basePrice) << endl;
     
     Pizza* withBoth = new StuffedCrust(withCheese);
-    double fullPrice = withBoth->getPrice();
+    Money fullPrice = withBoth->getPrice();
     cout << "With Both Decorators: R" << fullPrice << endl;
     cout << "Total price increase: R" << (fullPrice - basePrice) << endl;
     
@@ -1587,6 +1608,1472 @@ void testFactoryMethodsDetailedOutput() {
     }
 }
 
+void testToppingCatalogIds() {
+    cout << "\n=== Testing Topping Catalog IDs ===" << endl;
+    
+    CatalogSnapshot catalog = ToppingCatalog::current();
+    cout << "Catalog size: " << catalog->size() << endl;
+    
+    // Every name resolves to a dense ID and back again
+    for (size_t i = 0; i < catalog->size(); ++i) {
+        ToppingId id = static_cast<ToppingId>(i);
+        cout << "ID " << id << ": " << catalog->getName(id) << " - R" << catalog->getPrice(id)
+             << " (round trip " << (catalog->findId(catalog->getName(id)) == id ? "OK" : "FAILED") << ")" << endl;
+    }
+    
+    // Unknown names and IDs
+    cout << "ID of 'Pineapple': " << catalog->findId("Pineapple") << endl;
+    cout << "Price of ID 999: R" << catalog->getPrice(999) << endl;
+    
+    // Toppings built from an ID and from a name are the same topping
+    ToppingId olives = catalog->findId("Olives");
+    Topping byId(olives);
+    Topping byName("Olives");
+    cout << "By ID: " << byId.getName() << " - R" << byId.getPrice() << " (ID " << byId.getId() << ")" << endl;
+    cout << "By name: " << byName.getName() << " - R" << byName.getPrice() << " (ID " << byName.getId() << ")" << endl;
+    
+    // ID based custom pizza factory
+    vector<ToppingId> ids = {catalog->findId("Pepperoni"), olives};
+    ToppingGroup* custom = ToppingGroup::createCustomPizza(ids);
+    cout << "Custom from IDs: " << custom->getName() << " - R" << custom->getPrice() << endl;
+    delete custom;
+    
+    cout << endl;
+}
+
+void testCatalogHotReload() {
+    cout << "\n=== Testing Catalog Hot Reload ===" << endl;
+    
+    const string catalogFile = "test_catalog.txt";
+    {
+        ofstream out(catalogFile.c_str());
+        out << "# Test catalog\n";
+        out << "Dough, 10.00\nTomato Sauce, 5.00\nCheese, 15.00\n";
+        out << "Pepperoni, 30.00\nMushrooms, 12.00\nPineapple, 14.00\n";
+    }
+    
+    // The order pins the catalog version it was created under
+    PizzaOrders order(8001, "Catalog Test");
+    order.addPizza(order.createPepperoniPizza());
+    unsigned long versionBefore = order.getCatalogVersion();
+    Money totalBefore = order.getTotalPrice();
+    cout << "Order total before reload: R" << totalBefore << endl;
+    
+    bool loaded = ToppingCatalog::loadFromFile(catalogFile);
+    cout << "Reload succeeded: " << (loaded ? "Yes" : "No") << endl;
+    cout << "Latest version is newer: " << (ToppingCatalog::current()->getVersion() > versionBefore ? "Yes" : "No") << endl;
+    cout << "Existing order keeps its version: " << (order.getCatalogVersion() == versionBefore ? "Yes" : "No") << endl;
+    cout << "Existing order total after reload: R" << order.getTotalPrice() << endl;
+    
+    // New orders and unscoped pricing see the new prices
+    PizzaOrders newOrder(8002, "After Reload");
+    newOrder.addPizza(newOrder.createPepperoniPizza());
+    cout << "New order total: R" << newOrder.getTotalPrice() << endl;
+    cout << "Pineapple valid: " << (Topping::isValidTopping("Pineapple") ? "Yes" : "No") << endl;
+    cout << "Salami valid (not in file): " << (Topping::isValidTopping("Salami") ? "Yes" : "No") << endl;
+    
+    // An order that is still being built can move to the latest prices
+    cout << "Refresh allowed: " << (order.refreshCatalog() ? "Yes" : "No") << endl;
+    cout << "Order total after refresh: R" << order.getTotalPrice() << endl;
+    
+    // A bad file leaves the catalog untouched
+    {
+        ofstream out(catalogFile.c_str());
+        out << "Pepperoni, not-a-price\n";
+    }
+    unsigned long versionGood = ToppingCatalog::current()->getVersion();
+    cout << "Bad file loaded: " << (ToppingCatalog::loadFromFile(catalogFile) ? "Yes" : "No") << endl;
+    cout << "Version unchanged: " << (ToppingCatalog::current()->getVersion() == versionGood ? "Yes" : "No") << endl;
+    remove(catalogFile.c_str());
+    
+    // Pricing threads keep running while the catalog is swapped underneath them
+    Pizza* pizza = order.createPepperoniPizza();
+    atomic<bool> consistent(true);
+    vector<thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.push_back(thread([pizza, &consistent]() {
+            for (int i = 0; i < 2000; ++i) {
+                Money price = pizza->getPrice();
+                if (price != Money::fromRands(50) && price != Money::fromRands(60)) {
+                    consistent = false;
+                }
+            }
+        }));
+    }
+    for (int i = 0; i < 50; ++i) {
+        ToppingCatalog::registerTopping("Pepperoni", Money::fromRands((i % 2 == 0) ? 20 : 30));
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    cout << "Concurrent prices consistent: " << (consistent ? "Yes" : "No") << endl;
+    delete pizza;
+    
+    ToppingCatalog::resetToDefaults();
+    cout << "Pepperoni after reset: R" << Topping("Pepperoni").getPrice() << endl;
+    cout << endl;
+}
+
+void testCatalogImage() {
+    cout << "\n=== Testing Memory-Mapped Catalog Image ===" << endl;
+    
+    const string imageFile = "test_catalog.img";
+    
+    // Write the catalog, the predefined recipes and a small menu
+    ToppingGroup* pepperoni = ToppingGroup::createPepperoniPizza();
+    ToppingGroup* meatLovers = ToppingGroup::createMeatLoversPizza();
+    ToppingGroup* vegDeluxe = ToppingGroup::createVegetarianDeluxePizza();
+    vector<const ToppingGroup*> recipes = {pepperoni, meatLovers, vegDeluxe};
+    vector<ImageMenuEntry> entries = {
+        {"Pepperoni", false, false, false, ""},
+        {"Meat Lovers", true, false, false, ""},
+        {"Vegetarian Deluxe", false, true, true, "Weekend deal"}
+    };
+    bool written = CatalogImage::write(imageFile, *ToppingCatalog::current(), recipes, entries);
+    cout << "Image written: " << (written ? "Yes" : "No") << endl;
+    
+    shared_ptr<const CatalogImage> image = CatalogImage::open(imageFile);
+    cout << "Image opened: " << (image ? "Yes" : "No") << endl;
+    if (!image) {
+        delete pepperoni;
+        delete meatLovers;
+        delete vegDeluxe;
+        return;
+    }
+    cout << "Toppings: " << image->getToppingCount() << ", Recipes: " << image->getRecipeCount()
+         << ", Menu entries: " << image->getMenuEntryCount() << endl;
+    cout << "Lookup 'Salami': ID " << image->findTopping("Salami")
+         << " (catalog ID " << ToppingCatalog::current()->findId("Salami") << ")" << endl;
+    cout << "Lookup 'Pineapple': " << image->findTopping("Pineapple") << endl;
+    
+    // Recipes rebuilt from the image match the factories
+    ToppingGroup* rebuilt = image->buildRecipe(static_cast<uint32_t>(image->findRecipe("Meat Lovers")));
+    cout << "Rebuilt: " << rebuilt->getName() << " - R" << rebuilt->getPrice() << endl;
+    cout << "Matches factory: " << (rebuilt->getName() == meatLovers->getName() &&
+                                    rebuilt->getPrice() == meatLovers->getPrice() ? "Yes" : "No") << endl;
+    delete rebuilt;
+    
+    // Null recipes are skipped without shifting the menu's recipe indices
+    const string gappedFile = "test_gapped.img";
+    vector<const ToppingGroup*> gapped = {nullptr, pepperoni, nullptr, meatLovers};
+    vector<ImageMenuEntry> gappedEntries = {{"Meat Lovers", false, false, false, ""}};
+    bool gappedWritten = CatalogImage::write(gappedFile, *ToppingCatalog::current(), gapped, gappedEntries);
+    shared_ptr<const CatalogImage> gappedImage = CatalogImage::open(gappedFile);
+    cout << "Written with null recipes first: " << (gappedWritten && gappedImage ? "Yes" : "No") << endl;
+    if (gappedImage) {
+        Pizza* gappedPizza = gappedImage->buildMenuPizza(0);
+        cout << "Menu entry builds Meat Lovers: "
+             << (gappedPizza != nullptr && gappedPizza->getPrice() == meatLovers->getPrice() ? "Yes" : "No") << endl;
+        delete gappedPizza;
+    }
+    gappedImage.reset();
+    remove(gappedFile.c_str());
+    delete pepperoni;
+    delete meatLovers;
+    delete vegDeluxe;
+    
+    // Pricing can run straight off the mapped price table
+    bool installed = ToppingCatalog::installImage(image);
+    cout << "Image installed: " << (installed ? "Yes" : "No") << endl;
+    cout << "Catalog backed by image: " << (ToppingCatalog::current()->getImage() ? "Yes" : "No") << endl;
+    cout << "Olives from image: R" << Topping("Olives").getPrice() << endl;
+    
+    // Menus load their entries from the image
+    PizzaMenu menu("Image Menu");
+    SpecialsMenu specials("Image Specials");
+    cout << "Main menu entries loaded: " << menu.loadFromImage(*image) << endl;
+    cout << "Specials loaded: " << specials.loadFromImage(*image) << endl;
+    menu.displayMenu();
+    specials.displaySpecialsMenu();
+    
+    // Corrupt images are rejected (a mapped image is never modified in place)
+    const string corruptFile = "test_corrupt.img";
+    {
+        ofstream out(corruptFile.c_str(), ios::binary | ios::trunc);
+        out << string(512, 'x');
+    }
+    cout << "Corrupt image opened: " << (CatalogImage::open(corruptFile) ? "Yes" : "No") << endl;
+    remove(corruptFile.c_str());
+    remove(imageFile.c_str());
+    
+    ToppingCatalog::resetToDefaults();
+    cout << endl;
+}
+
+void testToppingFlyweights() {
+    cout << "\n=== Testing Shared Topping Flyweights ===" << endl;
+    
+    ToppingId pepperoniId = ToppingCatalog::current()->findId("Pepperoni");
+    const Topping* shared = Topping::intern(pepperoniId);
+    cout << "Interned Pepperoni: " << shared->getName() << " - R" << shared->getPrice()
+         << " (shared: " << (shared->isShared() ? "Yes" : "No") << ")" << endl;
+    cout << "Same instance on every lookup: " << (Topping::intern(pepperoniId) == shared ? "Yes" : "No") << endl;
+    cout << "Unknown ID interned: " << (Topping::intern(999) ? "Yes" : "No") << endl;
+    
+    // Two pizzas built by the factory reference the same leaf
+    ToppingGroup* first = ToppingGroup::createPepperoniPizza();
+    ToppingGroup* second = ToppingGroup::createPepperoniPizza();
+    cout << "Factories share leaves: " << (first->getComponents()[1] == second->getComponents()[1] &&
+                                           first->getComponents()[1] == shared ? "Yes" : "No") << endl;
+    
+    // Copies reference the same leaves and only copy the groups
+    ToppingGroup copy(*first);
+    const ToppingGroup* copiedBase = dynamic_cast<const ToppingGroup*>(copy.getComponents()[0]);
+    const ToppingGroup* originalBase = dynamic_cast<const ToppingGroup*>(first->getComponents()[0]);
+    cout << "Copy shares leaves: " << (copy.getComponents()[1] == shared &&
+                                       copiedBase->getComponents()[0] == originalBase->getComponents()[0] ? "Yes" : "No") << endl;
+    cout << "Copy has its own groups: " << (copiedBase != originalBase ? "Yes" : "No") << endl;
+    
+    // Destroying a group leaves the interned toppings alone
+    delete first;
+    delete second;
+    cout << "Copy after originals deleted: " << copy.getName() << " - R" << copy.getPrice() << endl;
+    
+    // Copying an interned topping gives a privately owned one
+    Topping owned(*shared);
+    cout << "Copied topping shared: " << (owned.isShared() ? "Yes" : "No") << endl;
+    
+    // Interned toppings follow catalog reloads because they only hold an ID
+    ToppingCatalog::registerTopping("Pepperoni", Money::fromRands(26));
+    cout << "Interned Pepperoni after reprice: R" << shared->getPrice()
+         << " (same instance: " << (Topping::intern(pepperoniId) == shared ? "Yes" : "No") << ")" << endl;
+    ToppingCatalog::resetToDefaults();
+    cout << endl;
+}
+
+void testMoneyArithmetic() {
+    cout << "\n=== Testing Money Arithmetic ===" << endl;
+    
+    // Ten cents added ten times is exactly one rand
+    Money sum;
+    for (int i = 0; i < 10; ++i) {
+        sum += Money::fromCents(10);
+    }
+    cout << "10 x R0.10 = R" << sum << " (exact: " << (sum == Money::fromRands(1) ? "Yes" : "No") << ")" << endl;
+    
+    // Parsing
+    Money parsed;
+    cout << "Parse '12.5': " << (Money::parse("12.5", parsed) ? parsed.toString() : "rejected") << endl;
+    cout << "Parse '0.05': " << (Money::parse("0.05", parsed) ? parsed.toString() : "rejected") << endl;
+    cout << "Parse '1.234': " << (Money::parse("1.234", parsed) ? parsed.toString() : "rejected") << endl;
+    cout << "Parse 'abc': " << (Money::parse("abc", parsed) ? parsed.toString() : "rejected") << endl;
+    
+    // Percentages round half away from zero to the nearest cent
+    cout << "15% of R0.10: R" << Money::fromCents(10).percent(15) << endl;
+    cout << "12% of R207.00: R" << Money::fromRands(207).percent(12) << endl;
+    cout << "10% of R0.05: R" << Money::fromCents(5).percent(10) << endl;
+    cout << "10% of -R0.05: R" << Money::fromCents(-5).percent(10) << endl;
+    
+    // Decorated pizza prices are exact sums of their parts
+    Pizza* pizza = new StuffedCrust(new ExtraCheese(new BasePizza(ToppingGroup::createPepperoniPizza())));
+    Money expected = Money::fromRands(50) + ExtraCheese::getExtraCheesePrice() + StuffedCrust::getStuffedCrustPrice();
+    cout << "Decorated pepperoni: R" << pizza->getPrice()
+         << " (exact: " << (pizza->getPrice() == expected ? "Yes" : "No") << ")" << endl;
+    delete pizza;
+    cout << endl;
+}
+
+void testToppingGroupPriceCache() {
+    cout << "\n=== Testing Cached Group Prices ===" << endl;
+    
+    ToppingGroup* meatLovers = ToppingGroup::createMeatLoversPizza();
+    cout << "Meat Lovers: R" << meatLovers->getPrice() << endl;
+    cout << "Repeated: R" << meatLovers->getPrice() << endl;
+    
+    // Changing a nested group invalidates every group above it
+    ToppingGroup* pepperoniGroup = dynamic_cast<ToppingGroup*>(meatLovers->getComponents()[0]);
+    ToppingGroup* base = dynamic_cast<ToppingGroup*>(pepperoniGroup->getComponents()[0]);
+    Topping* extra = new Topping("Olives");
+    base->addComponent(extra);
+    cout << "After adding Olives to the nested base: R" << meatLovers->getPrice() << endl;
+    base->removeComponent(extra);
+    delete extra;
+    cout << "After removing them again: R" << meatLovers->getPrice() << endl;
+    
+    // A repriced catalog is a new version, so the cached total is not reused
+    ToppingCatalog::registerTopping("Salami", Money::fromRands(30));
+    cout << "After repricing Salami: R" << meatLovers->getPrice() << endl;
+    ToppingCatalog::resetToDefaults();
+    cout << "After reset: R" << meatLovers->getPrice() << endl;
+    
+    // Clearing a nested group and assigning over one
+    pepperoniGroup->clearComponents();
+    cout << "After clearing the nested Pepperoni group: R" << meatLovers->getPrice() << endl;
+    ToppingGroup* vegetarian = ToppingGroup::createVegetarianPizza();
+    *pepperoniGroup = *vegetarian;
+    cout << "After assigning Vegetarian to it: R" << meatLovers->getPrice()
+         << " (expected R" << (vegetarian->getPrice() + Money::fromRands(47)) << ")" << endl;
+    delete vegetarian;
+    delete meatLovers;
+    cout << endl;
+}
+
+void testNameRenderer() {
+    cout << "\n=== Testing Name Renderer ===" << endl;
+    
+    Pizza* pizza = new StuffedCrust(new ExtraCheese(new BasePizza(ToppingGroup::createMeatLoversPizza())));
+    string expected = pizza->getName();
+    cout << "Name: " << expected << endl;
+    cout << "Length known up front: " << (nameLength(*pizza) == expected.size() ? "Yes" : "No") << endl;
+    
+    // Caller-supplied buffer: the full length is reported even when it doesn't fit
+    char small[16];
+    size_t length = renderName(*pizza, small, sizeof(small));
+    cout << "Truncated to buffer: '" << string(small, sizeof(small)) << "' (full length "
+         << (length == expected.size() ? "reported" : "wrong") << ")" << endl;
+    
+    // Appending to an existing string and streaming
+    string line = "Order: ";
+    appendName(line, *pizza);
+    cout << "Appended matches: " << (line == "Order: " + expected ? "Yes" : "No") << endl;
+    ostringstream streamed;
+    streamed << nameOf(*pizza);
+    cout << "Streamed matches: " << (streamed.str() == expected ? "Yes" : "No") << endl;
+    delete pizza;
+    
+    // Names longer than the stream's stack buffer
+    ToppingGroup* nested = new ToppingGroup("Level 0");
+    ToppingGroup* current = nested;
+    for (int i = 1; i < 30; ++i) {
+        ToppingGroup* child = new ToppingGroup("Level " + to_string(i));
+        child->addTopping(ToppingCatalog::current()->findId("Mushrooms"));
+        current->addComponent(child);
+        current = child;
+    }
+    Pizza* deep = new BasePizza(nested);
+    ostringstream longName;
+    longName << nameOf(*deep);
+    cout << "Long name (" << deep->getName().size() << " chars) streamed: "
+         << (longName.str() == deep->getName() ? "OK" : "FAILED") << endl;
+    delete deep;
+    cout << endl;
+}
+
+void testFrozenRecipes() {
+    cout << "\n=== Testing Frozen Recipes ===" << endl;
+    
+    Pizza* pizza = new StuffedCrust(new ExtraCheese(new BasePizza(ToppingGroup::createMeatLoversPizza())));
+    FrozenRecipe* frozen = FrozenRecipe::freeze(*pizza);
+    cout << "Frozen: " << frozen->getNodeCount() << " nodes, " << frozen->getModifierCount() << " modifiers" << endl;
+    cout << "Name: " << frozen->getName() << endl;
+    cout << "Price: R" << frozen->getPrice() << endl;
+    cout << "Matches original: " << (frozen->getName() == pizza->getName() &&
+                                     frozen->getPrice() == pizza->getPrice() ? "Yes" : "No") << endl;
+    
+    // Equal recipes hash equally, different ones don't
+    Pizza* same = new StuffedCrust(new ExtraCheese(new BasePizza(ToppingGroup::createMeatLoversPizza())));
+    Pizza* other = new ExtraCheese(new StuffedCrust(new BasePizza(ToppingGroup::createMeatLoversPizza())));
+    FrozenRecipe* sameFrozen = FrozenRecipe::freeze(*same);
+    FrozenRecipe* otherFrozen = FrozenRecipe::freeze(*other);
+    cout << "Same recipe, same hash: " << (frozen->hash() == sameFrozen->hash() ? "Yes" : "No") << endl;
+    cout << "Decorator order changes hash: " << (frozen->hash() != otherFrozen->hash() ? "Yes" : "No") << endl;
+    delete same;
+    delete other;
+    delete sameFrozen;
+    delete otherFrozen;
+    
+    // Frozen prices follow catalog changes through the topping IDs
+    ToppingCatalog::registerTopping("Salami", Money::fromRands(30));
+    cout << "After repricing Salami: R" << frozen->getPrice()
+         << " (original R" << pizza->getPrice() << ")" << endl;
+    ToppingCatalog::resetToDefaults();
+    
+    // Serialisation round trip
+    string bytes = frozen->serialize();
+    FrozenRecipe* loaded = FrozenRecipe::deserialize(bytes);
+    cout << "Serialized size: " << bytes.size() << " bytes" << endl;
+    cout << "Round trip: " << (loaded != nullptr && loaded->hash() == frozen->hash() &&
+                               loaded->getName() == frozen->getName() ? "OK" : "FAILED") << endl;
+    cout << "Truncated data rejected: " << (FrozenRecipe::deserialize(bytes.substr(0, bytes.size() - 1)) == nullptr ? "Yes" : "No") << endl;
+    delete loaded;
+    
+    // Blob layout: 24-byte header, then per-node kinds (1 byte), topping IDs
+    // (4 bytes) and stored prices (8 bytes)
+    size_t nodes = frozen->getNodeCount();
+    string badId = bytes;
+    const int32_t negativeId = -100000;
+    memcpy(&badId[24 + nodes], &negativeId, sizeof(negativeId));
+    cout << "Negative topping ID rejected: " << (FrozenRecipe::deserialize(badId) == nullptr ? "Yes" : "No") << endl;
+    string pastEnd = bytes;
+    const int32_t pastEndId = static_cast<int32_t>(ToppingCatalog::current()->size());
+    memcpy(&pastEnd[24 + nodes + (nodes - 1) * 4], &pastEndId, sizeof(pastEndId));
+    cout << "Topping ID past the catalog rejected: " << (FrozenRecipe::deserialize(pastEnd) == nullptr ? "Yes" : "No") << endl;
+    
+    // Stored prices are ignored after a round trip (versions are per process)
+    string stalePrices = bytes;
+    for (size_t i = 0; i < nodes; ++i) {
+        const int64_t stale = 1;
+        memcpy(&stalePrices[24 + nodes * 5 + i * 8], &stale, sizeof(stale));
+    }
+    FrozenRecipe* reloaded = FrozenRecipe::deserialize(stalePrices);
+    cout << "Thawed blob prices from the catalog: " << (reloaded != nullptr && reloaded->getPrice() == frozen->getPrice() ? "Yes" : "No") << endl;
+    delete reloaded;
+    
+    // ...including the price of a topping the catalog doesn't know
+    ToppingGroup unknownGroup("Odd");
+    unknownGroup.addComponent(new Topping("Pineapple"));
+    FrozenRecipe* unknownFrozen = FrozenRecipe::freeze(unknownGroup);
+    string unknownBytes = unknownFrozen->serialize();
+    const int64_t forged = 5000;
+    memcpy(&unknownBytes[24 + 2 * 5 + 8], &forged, sizeof(forged));
+    FrozenRecipe* unknownLoaded = FrozenRecipe::deserialize(unknownBytes);
+    cout << "Unknown topping price ignored: " << (unknownLoaded != nullptr && unknownLoaded->getPrice() == Money() ? "Yes" : "No") << endl;
+    delete unknownLoaded;
+    delete unknownFrozen;
+    
+    // Thaw, edit and freeze again
+    Pizza* thawed = frozen->toPizza();
+    cout << "Thawed: " << thawed->getName() << " - R" << thawed->getPrice() << endl;
+    ToppingGroup* group = frozen->toGroup();
+    group->addTopping(ToppingCatalog::current()->findId("Olives"));
+    FrozenRecipe* edited = FrozenRecipe::freeze(*group);
+    cout << "Edited: " << edited->getName() << " - R" << edited->getPrice() << endl;
+    delete edited;
+    delete group;
+    delete thawed;
+    
+    // Empty pizzas freeze too
+    BasePizza empty(nullptr);
+    FrozenRecipe* frozenEmpty = FrozenRecipe::freeze(empty);
+    cout << "Empty: " << frozenEmpty->getName() << " - R" << frozenEmpty->getPrice() << endl;
+    delete frozenEmpty;
+    
+    delete frozen;
+    delete pizza;
+    cout << endl;
+}
+
+void testOrderArena() {
+    cout << "\n=== Testing Per-Order Arena ===" << endl;
+    
+    // Existing callers still get heap allocated composites
+    ToppingGroup* heapGroup = ToppingGroup::createPepperoniPizza();
+    cout << "Factory default is the heap: " << (&heapGroup->getResource() == &MemoryResource::heap() ? "Yes" : "No") << endl;
+    delete heapGroup;
+    
+    // A standalone arena
+    {
+        MonotonicArena arena;
+        Pizza* pizza = new (arena) ExtraCheese(new (arena) BasePizza(ToppingGroup::createMeatLoversPizza(arena)));
+        cout << "Arena pizza: " << pizza->getName() << " - R" << pizza->getPrice() << endl;
+        cout << "Arena in use: " << (arena.getBytesUsed() > 0 ? "Yes" : "No")
+             << ", chunks: " << arena.getChunkCount() << endl;
+        
+        // Copies can go to the heap or back into the arena
+        Pizza* heapCopy = pizza->clone();
+        Pizza* arenaCopy = pizza->cloneInto(arena);
+        cout << "Copies match: " << (heapCopy->getName() == pizza->getName() &&
+                                     arenaCopy->getPrice() == pizza->getPrice() ? "Yes" : "No") << endl;
+        delete heapCopy;
+        delete arenaCopy;  // Runs the destructors, the memory goes back with the arena
+        delete pizza;
+    }
+    
+    // Orders allocate every pizza they create or copy from their own arena
+    PizzaOrders order(9101, "Arena Order");
+    order.addPizza(order.createMeatLoversPizza(true, true));
+    order.addPizza(order.createCustomPizza({"Mushrooms", "Olives"}, true, false));
+    size_t used = order.getArenaBytesUsed();
+    cout << "Order arena in use: " << (used > 0 ? "Yes" : "No") << endl;
+    
+    // Pizzas made elsewhere can still be added and are freed normally
+    order.addPizza(new BasePizza(ToppingGroup::createVegetarianPizza()));
+    cout << "Heap pizza added without using the arena: " << (order.getArenaBytesUsed() == used ? "Yes" : "No") << endl;
+    
+    PizzaOrders copy(order);
+    cout << "Copied order total: R" << copy.getTotalPrice() << " (original R" << order.getTotalPrice() << ")" << endl;
+    cout << "Copy has its own arena: " << (copy.getArenaBytesUsed() > 0 ? "Yes" : "No") << endl;
+    
+    // Assigning again reuses the arena instead of growing it
+    PizzaOrders assigned(9102, "Assigned Order");
+    assigned = order;
+    size_t afterFirst = assigned.getArenaBytesUsed();
+    for (int i = 0; i < 50; ++i) {
+        assigned = order;
+    }
+    cout << "Arena steady over repeated assignment: " << (assigned.getArenaBytesUsed() == afterFirst ? "Yes" : "No") << endl;
+    
+    // Created pizzas end with the order's arena; a heap copy outlives a reset
+    PizzaOrders reused(9103, "Reused Order");
+    Pizza* created = reused.createPepperoniPizza(true, false);
+    Pizza* kept = created->clone();
+    string createdName = created->getName();
+    reused.addPizza(created);
+    reused.reset(9104, "Next Customer");
+    reused.addPizza(reused.createVegetarianPizza());
+    cout << "Heap copy outlives the reset: " << (kept->getName() == createdName ? "Yes" : "No") << endl;
+    delete kept;
+    cout << endl;
+}
+
+void testCopyOnWriteGroups() {
+    cout << "\n=== Testing Copy-on-Write Groups ===" << endl;
+    
+    ToppingGroup* original = ToppingGroup::createMeatLoversPizza();
+    Money originalPrice = original->getPrice();
+    string originalName = original->getName();
+    
+    // Copies share the component list until one of them changes
+    ToppingGroup* copy = new ToppingGroup(*original);
+    cout << "Copy shares components: " << (copy->sharesComponents() && original->sharesComponents() ? "Yes" : "No") << endl;
+    
+    // Changing the copy leaves the original alone
+    copy->addTopping(ToppingCatalog::current()->findId("Olives"));
+    cout << "Copy after adding Olives: R" << copy->getPrice() << endl;
+    cout << "Original unchanged: " << (original->getName() == originalName &&
+                                       original->getPrice() == originalPrice ? "Yes" : "No") << endl;
+    cout << "Lists separated: " << (!copy->sharesComponents() && !original->sharesComponents() ? "Yes" : "No") << endl;
+    
+    // Nested groups are copied lazily too: reaching one to change it only
+    // unshares the groups on the way down
+    ToppingGroup nestedCopy(*original);
+    ToppingGroup* pepperoni = dynamic_cast<ToppingGroup*>(nestedCopy.getComponents()[0]);
+    cout << "Nested group still shared: " << (pepperoni->sharesComponents() ? "Yes" : "No") << endl;
+    ToppingGroup* base = dynamic_cast<ToppingGroup*>(pepperoni->getComponents()[0]);
+    base->clearComponents();
+    cout << "Copy after clearing its base: R" << nestedCopy.getPrice() << endl;
+    cout << "Original unchanged: " << (original->getPrice() == originalPrice ? "Yes" : "No") << endl;
+    
+    // Removing a component the copies still share only drops this group's copy of it
+    ToppingGroup removeCopy(*original);
+    PizzaComponent* salami = original->getComponents()[2];
+    cout << "Removed from shared list: " << (removeCopy.removeComponent(salami) ? "Yes" : "No")
+         << " (copy " << removeCopy.getComponentCount() << " components, original "
+         << original->getComponentCount() << ")" << endl;
+    
+    // Copying a deep tree only takes a reference
+    ToppingGroup* deep = new ToppingGroup("Level 0");
+    ToppingGroup* current = deep;
+    for (int i = 1; i < 200; ++i) {
+        ToppingGroup* child = new ToppingGroup("Level " + to_string(i));
+        current->addComponent(child);
+        current = child;
+    }
+    current->addTopping(ToppingCatalog::current()->findId("Cheese"));
+    ToppingGroup deepCopy(*deep);
+    cout << "Deep copy shares: " << (deepCopy.sharesComponents() ? "Yes" : "No")
+         << ", price R" << deepCopy.getPrice() << endl;
+    
+    // The copy outlives the original
+    delete original;
+    delete deep;
+    cout << "Copies after originals deleted: R" << nestedCopy.getPrice() << ", R" << deepCopy.getPrice() << endl;
+    delete copy;
+    
+    // Nested groups of a list that outlives its original are relinked to the
+    // group that changes them, so the change reaches the right totals
+    ToppingId olives = ToppingCatalog::current()->findId("Olives");
+    ToppingGroup* source = ToppingGroup::createMeatLoversPizza();
+    Money sourcePrice = source->getPrice();
+    ToppingGroup* survivor = new ToppingGroup(*source);
+    ToppingGroup sibling(*survivor);
+    delete source;
+    ToppingGroup* survivorNested = dynamic_cast<ToppingGroup*>(survivor->getComponents()[0]);
+    survivorNested->addTopping(olives);
+    Money survivorPrice = survivor->getPrice();
+    cout << "Survivor sees nested change: " << (survivorPrice > sourcePrice ? "Yes" : "No") << endl;
+    cout << "Sibling unchanged: " << (sibling.getPrice() == sourcePrice ? "Yes" : "No") << endl;
+    delete survivor;
+    ToppingGroup* siblingNested = dynamic_cast<ToppingGroup*>(sibling.getComponents()[0]);
+    siblingNested->addTopping(olives);
+    cout << "Last holder sees nested change: " << (sibling.getPrice() == survivorPrice ? "Yes" : "No") << endl;
+    
+    // Menu pizzas are shared by the orders they are copied into, but groups
+    // built in one order's arena are copied into another's
+    BasePizza menuPizza(ToppingGroup::createPepperoniPizza());
+    PizzaOrders order(9102, "Copy on Write");
+    order.addPizza(order.clonePizza(&menuPizza));
+    order.addPizza(order.createCustomPizza({"Olives"}, false, false));
+    ToppingGroup* fromMenu = dynamic_cast<ToppingGroup*>(dynamic_cast<BasePizza*>(order.getPizzas()[0])->getToppings());
+    cout << "Order copy of menu pizza shares: " << (fromMenu->sharesComponents() ? "Yes" : "No") << endl;
+    {
+        PizzaOrders copiedOrder(order);
+        ToppingGroup* fromArena = dynamic_cast<ToppingGroup*>(
+            dynamic_cast<BasePizza*>(copiedOrder.getPizzas()[1])->getToppings());
+        cout << "Copied order total: R" << copiedOrder.getTotalPrice()
+             << ", arena pizza shared: " << (fromArena->sharesComponents() ? "Yes" : "No") << endl;
+    }
+    cout << "Original order after copy is gone: R" << order.getTotalPrice() << endl;
+    cout << endl;
+}
+
+void testComponentClone() {
+    cout << "\n=== Testing Virtual Component Clone ===" << endl;
+    
+    // Components copy themselves through the base class
+    const PizzaComponent* shared = Topping::intern(ToppingCatalog::current()->findId("Salami"));
+    PizzaComponent* leaf = shared->clone();
+    cout << "Cloned topping: " << leaf->getName() << " - R" << leaf->getPrice()
+         << " (kind topping: " << (leaf->getKind() == PizzaComponent::TOPPING ? "Yes" : "No")
+         << ", shared: " << (leaf->isShared() ? "Yes" : "No") << ")" << endl;
+    delete leaf;
+    
+    ToppingGroup* deluxe = ToppingGroup::createVegetarianDeluxePizza();
+    const PizzaComponent* component = deluxe;
+    PizzaComponent* group = component->clone();
+    cout << "Cloned group: " << group->getName() << " - R" << group->getPrice()
+         << " (kind group: " << (group->getKind() == PizzaComponent::GROUP ? "Yes" : "No") << ")" << endl;
+    
+    // Copying across arenas walks every node through the same protocol
+    {
+        MonotonicArena source;
+        MonotonicArena target;
+        Pizza* original = new (source) BasePizza(ToppingGroup::createVegetarianDeluxePizza(source));
+        Pizza* copy = original->cloneInto(target);
+        cout << "Cross-arena copy matches: " << (copy->getName() == original->getName() &&
+                                                 copy->getPrice() == original->getPrice() ? "Yes" : "No") << endl;
+        delete original;
+        cout << "Copy after original deleted: R" << copy->getPrice() << endl;
+        delete copy;
+    }
+    
+    delete group;
+    delete deluxe;
+    cout << endl;
+}
+
+void testRecipeRegistry() {
+    cout << "\n=== Testing Recipe Registry ===" << endl;
+    
+    cout << "Recipes:";
+    for (const string& recipe : RecipeRegistry::getRecipeNames()) {
+        cout << " [" << recipe << "]";
+    }
+    cout << endl;
+    
+    // Instances share the prototype instead of rebuilding the tree
+    ToppingGroup* built = ToppingGroup::createMeatLoversPizza();
+    ToppingGroup* instance = RecipeRegistry::instantiate("Meat Lovers");
+    cout << "Matches the factory: " << (instance->getName() == built->getName() &&
+                                        instance->getPrice() == built->getPrice() ? "Yes" : "No") << endl;
+    cout << "Shares the prototype: " << (instance->sharesComponents() ? "Yes" : "No") << endl;
+    cout << "Unknown recipe: " << (RecipeRegistry::instantiate("Calzone") ? "found" : "nullptr") << endl;
+    delete built;
+    
+    // Orders hand out references to the prototypes
+    PizzaOrders order(9103, "Registry Order");
+    order.addPizza(order.createMeatLoversPizza(true, false));
+    order.addPizza(order.createPizza("Vegetarian Deluxe"));
+    cout << "Order total: R" << order.getTotalPrice() << endl;
+    
+    // A new recipe only needs a line in the file
+    const string recipeFile = "test_recipes.txt";
+    {
+        ofstream out(recipeFile.c_str());
+        out << "# Test recipes\n";
+        out << RecipeRegistry::DEFAULT_RECIPES;
+        out << "Supreme: @Meat Lovers, Mushrooms, Olives\n";
+    }
+    cout << "Loaded recipe file: " << (RecipeRegistry::loadFromFile(recipeFile) ? "Yes" : "No") << endl;
+    Pizza* supreme = order.createPizza("Supreme", false, true);
+    cout << "New recipe: " << supreme->getName() << " - R" << supreme->getPrice() << endl;
+    order.addPizza(supreme);
+    
+    // Bad files are rejected and the current recipes stay
+    {
+        ofstream out(recipeFile.c_str());
+        out << "Base: Dough, Tomato Sauce, Cheese\nMargherita: @Base, Basil\n";
+    }
+    cout << "Unknown topping file loaded: " << (RecipeRegistry::loadFromFile(recipeFile) ? "Yes" : "No") << endl;
+    {
+        ofstream out(recipeFile.c_str());
+        out << "Meat Lovers: @Pepperoni, Salami\nPepperoni: @Base, Pepperoni\n";
+    }
+    cout << "Forward reference file loaded: " << (RecipeRegistry::loadFromFile(recipeFile) ? "Yes" : "No") << endl;
+    cout << "Supreme still available: " << (RecipeRegistry::contains("Supreme") ? "Yes" : "No") << endl;
+    remove(recipeFile.c_str());
+    
+    // Instances outlive the recipes they came from
+    RecipeRegistry::resetToDefaults();
+    cout << "Supreme after reset: " << (RecipeRegistry::contains("Supreme") ? "Yes" : "No") << endl;
+    cout << "Order after reset: R" << order.getTotalPrice() << endl;
+    cout << "Earlier instance: R" << instance->getPrice() << endl;
+    delete instance;
+    cout << endl;
+}
+
+// Compile-time recipes are checked by the compiler
+static_assert(StaticMeatLovers::defaultPrice() == Money::fromRands(97), "Meat Lovers price");
+static_assert(WithStuffedCrust<WithExtraCheese<StaticPepperoni> >::defaultPrice() == Money::fromRands(82),
+              "Decorated Pepperoni price");
+static_assert(StaticVegetarianDeluxe::toppingCount() == 8, "Vegetarian Deluxe toppings");
+static_assert(StaticPepperoni::nameLength() == sizeof("Pepperoni (Base (Dough, Tomato Sauce, Cheese), Pepperoni)") - 1,
+              "Pepperoni name");
+
+void testStaticRecipes() {
+    cout << "\n=== Testing Compile-Time Recipes ===" << endl;
+    
+    typedef WithStuffedCrust<WithExtraCheese<StaticMeatLovers> > Deluxe;
+    cout << "Name: " << StaticPizza<Deluxe>::name() << endl;
+    cout << "Compile-time price: R" << StaticPizza<Deluxe>::defaultPrice() << endl;
+    
+    // Same names and prices as the runtime trees
+    StaticPizza<StaticPepperoni> pepperoni;
+    StaticPizza<StaticVegetarian> vegetarian;
+    StaticPizza<StaticMeatLovers> meatLovers;
+    StaticPizza<StaticVegetarianDeluxe> vegetarianDeluxe;
+    StaticPizza<Deluxe> deluxe;
+    Pizza* staticPizzas[] = {&pepperoni, &vegetarian, &meatLovers, &vegetarianDeluxe, &deluxe};
+    Pizza* runtimePizzas[] = {
+        new BasePizza(ToppingGroup::createPepperoniPizza()),
+        new BasePizza(ToppingGroup::createVegetarianPizza()),
+        new BasePizza(ToppingGroup::createMeatLoversPizza()),
+        new BasePizza(ToppingGroup::createVegetarianDeluxePizza()),
+        new StuffedCrust(new ExtraCheese(new BasePizza(ToppingGroup::createMeatLoversPizza())))
+    };
+    bool same = true;
+    for (int i = 0; i < 5; ++i) {
+        same = same && staticPizzas[i]->getName() == runtimePizzas[i]->getName() &&
+               staticPizzas[i]->getPrice() == runtimePizzas[i]->getPrice() &&
+               nameLength(*staticPizzas[i]) == staticPizzas[i]->getName().size();
+    }
+    cout << "Match runtime pizzas: " << (same ? "Yes" : "No") << endl;
+    
+    // A repriced catalog is followed (the compile-time price is only used for default prices)
+    ToppingCatalog::registerTopping("Salami", Money::fromRands(30));
+    cout << "After repricing Salami: R" << deluxe.getPrice()
+         << " (runtime R" << runtimePizzas[4]->getPrice() << ")" << endl;
+    ToppingCatalog::resetToDefaults();
+    cout << "After reset: R" << deluxe.getPrice() << endl;
+    for (Pizza* pizza : runtimePizzas) {
+        delete pizza;
+    }
+    
+    // They work anywhere a Pizza does
+    PizzaOrders order(9104, "Static Order");
+    order.addPizza(new StaticPizza<StaticVegetarianDeluxe>());
+    order.addPizza(order.clonePizza(&deluxe));
+    cout << "Order total: R" << order.getTotalPrice() << endl;
+    cout << endl;
+}
+
+void testToppingQuantities() {
+    cout << "\n=== Testing Topping Quantities ===" << endl;
+    
+    // Repeated toppings are counted on one node
+    PizzaOrders order(9105, "Quantity Order");
+    Pizza* custom = order.createCustomPizza({"Pepperoni", "Pepperoni", "Cheese", "Pepperoni"});
+    cout << "Custom pizza: " << custom->getName() << " - R" << custom->getPrice() << endl;
+    order.addPizza(custom);
+    
+    ToppingId salami = ToppingCatalog::current()->findId("Salami");
+    ToppingGroup group("Salami Feast");
+    group.addTopping(salami);
+    group.addTopping(salami, 2);
+    group.addTopping(salami, 0);
+    cout << "Group: " << group.getName() << " - R" << group.getPrice()
+         << " (" << group.getComponentCount() << " component)" << endl;
+    
+    // The count survives copies, freezing and serialisation
+    ToppingGroup copy(group);
+    copy.addTopping(salami);
+    cout << "Copy after another portion: " << copy.getName() << " (original still "
+         << group.getName() << ")" << endl;
+    
+    FrozenRecipe* frozen = FrozenRecipe::freeze(group);
+    FrozenRecipe* restored = FrozenRecipe::deserialize(frozen->serialize());
+    ToppingGroup* thawed = restored->toGroup();
+    cout << "Round trip: " << restored->getName() << " - R" << restored->getPrice()
+         << " (same hash: " << (restored->hash() == frozen->hash() ? "Yes" : "No")
+         << ", thawed: " << thawed->getName() << ")" << endl;
+    ToppingGroup single("Salami Feast");
+    single.addTopping(salami);
+    FrozenRecipe* singleFrozen = FrozenRecipe::freeze(single);
+    cout << "Hash differs from one portion: " << (singleFrozen->hash() != frozen->hash() ? "Yes" : "No") << endl;
+    delete singleFrozen;
+    delete thawed;
+    delete restored;
+    delete frozen;
+    
+    Topping unknown("Truffle", 2);
+    cout << "Unknown topping: " << unknown.getName() << " - R" << unknown.getPrice() << endl;
+    cout << endl;
+}
+
+void testModifierSet() {
+    cout << "\n=== Testing Decorator Modifier Sets ===" << endl;
+    
+    // Decorator-style construction owns the pizza it was given, so pointers
+    // to the inner decorator stay valid, and folds the inner modifiers into
+    // its own set so pricing is one pass over both
+    Pizza* cheesy = new ExtraCheese(new BasePizza(ToppingGroup::createPepperoniPizza()));
+    Pizza* pizza = new StuffedCrust(cheesy);
+    PizzaDecorator* decorator = pizza->asDecorator();
+    cout << "Name: " << pizza->getName() << " - R" << pizza->getPrice() << endl;
+    cout << "Outer modifiers: " << decorator->getModifierCount()
+         << ", applied to the base pizza: " << (decorator->getWrappedPizza() == cheesy->asDecorator()->getWrappedPizza() ? "Yes" : "No")
+         << ", inner still usable: " << cheesy->getName() << " - R" << cheesy->getPrice() << endl;
+    
+    // Clones keep the concrete decorator type and the folded set
+    Pizza* pizzaCopy = pizza->clone();
+    cout << "Clone types kept: "
+         << (dynamic_cast<StuffedCrust*>(pizzaCopy) != nullptr &&
+             pizzaCopy->asDecorator()->getModifierCount() == 2 &&
+             pizzaCopy->asDecorator()->getWrappedPizza()->asDecorator() == nullptr &&
+             pizzaCopy->getName() == pizza->getName() ? "Yes" : "No") << endl;
+    delete pizzaCopy;
+    
+    // Modifier prices come from the catalog
+    ToppingCatalog::registerModifier(EXTRA_CHEESE, Money::fromRands(15));
+    StaticPizza<WithExtraCheese<StaticBase> > staticPizza;
+    cout << "Extra cheese repriced: R" << pizza->getPrice()
+         << " (static R" << staticPizza.getPrice() << ")" << endl;
+    ToppingCatalog::resetToDefaults();
+    cout << "After reset: R" << pizza->getPrice() << endl;
+    
+    // Each wrapper folds the ones inside it until the set is full, then
+    // starts a new one
+    Pizza* layered = new BasePizza(ToppingGroup::createPepperoniPizza());
+    for (int i = 0; i < 9; ++i) {
+        layered = new ExtraCheese(layered);
+    }
+    int layers = 0;
+    for (Pizza* layer = layered; layer->asDecorator() != nullptr; layer = layer->asDecorator()->getWrappedPizza()) {
+        ++layers;
+    }
+    cout << "Nine extra cheeses: " << layers << " layers, R" << layered->getPrice() << endl;
+    
+    // Clones and frozen recipes keep every modifier
+    Pizza* copy = layered->clone();
+    FrozenRecipe* frozen = FrozenRecipe::freeze(*layered);
+    Pizza* thawed = frozen->toPizza();
+    cout << "Clone matches: " << (copy->getName() == layered->getName() && copy->getPrice() == layered->getPrice() ? "Yes" : "No")
+         << ", frozen modifiers: " << frozen->getModifierCount()
+         << ", thawed matches: " << (thawed->getName() == layered->getName() ? "Yes" : "No") << endl;
+    delete thawed;
+    delete frozen;
+    delete copy;
+    delete layered;
+    
+    // Orders build one decorator for both add-ons
+    PizzaOrders order(9106, "Modifier Order");
+    Pizza* ordered = order.createVegetarianPizza(true, true);
+    cout << "Order pizza modifiers: " << ordered->asDecorator()->getModifierCount() << endl;
+    order.addPizza(ordered);
+    pizza->printPizza();
+    delete pizza;
+    cout << endl;
+}
+
+// Add-on suffixes and prices are compile-time constants
+static_assert(StaticDecorator<BasePizza, EXTRA_CHEESE, STUFFED_CRUST>::suffixLength() ==
+              sizeof(" + Extra Cheese + Stuffed Crust") - 1, "Static decorator suffix");
+static_assert(StaticDecorator<BasePizza, EXTRA_CHEESE, STUFFED_CRUST>::defaultModifierPrice() ==
+              ExtraCheese::getExtraCheesePrice() + StuffedCrust::getStuffedCrustPrice(), "Static decorator price");
+
+void testStaticDecorators() {
+    cout << "\n=== Testing Static Decorators ===" << endl;
+    
+    // Same name and price as the runtime decorators
+    typedef StaticDecorator<BasePizza, EXTRA_CHEESE, STUFFED_CRUST> CheeseAndCrust;
+    CheeseAndCrust* pizza = new CheeseAndCrust(new BasePizza(ToppingGroup::createMeatLoversPizza()));
+    Pizza* runtime = new StuffedCrust(new ExtraCheese(new BasePizza(ToppingGroup::createMeatLoversPizza())));
+    cout << "Suffix: \"" << CheeseAndCrust::suffix() << "\"" << endl;
+    cout << "Matches runtime decorators: " << (pizza->getName() == runtime->getName() &&
+                                               pizza->getPrice() == runtime->getPrice() ? "Yes" : "No") << endl;
+    
+    // Fully static pizza and add-ons
+    StaticDecorator<StaticPizza<StaticPepperoni>, STUFFED_CRUST> crustPizza(new StaticPizza<StaticPepperoni>());
+    cout << "Static pizza: " << crustPizza.getName() << " - R" << crustPizza.getPrice() << endl;
+    
+    // It is a runtime decorator too: repricing, wrapping and freezing all work
+    ToppingCatalog::registerModifier(STUFFED_CRUST, Money::fromRands(25));
+    cout << "Repriced crust: R" << pizza->getPrice() << " (runtime R" << runtime->getPrice() << ")" << endl;
+    ToppingCatalog::resetToDefaults();
+    
+    pizza->addModifier(EXTRA_CHEESE);
+    cout << "Extra modifier at run time: " << pizza->getName() << " - R" << pizza->getPrice() << endl;
+    Pizza* wrapped = new ExtraCheese(pizza);
+    FrozenRecipe* frozen = FrozenRecipe::freeze(*wrapped);
+    cout << "Folded around it: " << (wrapped->asDecorator()->getModifierCount() == 4 &&
+                                     wrapped->asDecorator()->getWrappedPizza() == pizza->getWrappedPizza() ? "Yes" : "No") << ", frozen: "
+         << (frozen != nullptr ? frozen->getName() : "failed") << endl;
+    delete frozen;
+    
+    // Orders build their add-on combinations with it
+    PizzaOrders order(9107, "Static Decorator Order");
+    Pizza* ordered = order.createPepperoniPizza(true, true);
+    Pizza* copy = ordered->clone();
+    cout << "Order pizza: " << ordered->getName() << " - R" << ordered->getPrice()
+         << " (clone matches: " << (copy->getName() == ordered->getName() ? "Yes" : "No") << ")" << endl;
+    order.addPizza(ordered);
+    delete copy;
+    delete wrapped;
+    delete runtime;
+    cout << endl;
+}
+
+void testPizzaHandles() {
+    cout << "\n=== Testing Pizza Handles ===" << endl;
+    
+    // Handles are built in one step or adopt an existing pizza
+    PizzaHandle base = PizzaHandle::make<BasePizza>(ToppingGroup::createPepperoniPizza());
+    PizzaHandle decorated = PizzaHandle::make<StaticDecorator<BasePizza, EXTRA_CHEESE> >(
+        new BasePizza(ToppingGroup::createVegetarianPizza()));
+    PizzaHandle adopted(new ExtraCheese(new BasePizza(ToppingGroup::createMeatLoversPizza())));
+    Pizza* decoratedPizza = decorated.get();
+    
+    // Moving moves the pizza; the source is left empty
+    vector<PizzaHandle> handles;
+    handles.push_back(std::move(base));
+    handles.push_back(std::move(decorated));
+    handles.push_back(std::move(adopted));
+    for (int i = 0; i < 8; ++i) {
+        handles.push_back(PizzaHandle::make<StaticPizza<StaticBase> >());
+    }
+    cout << "Moved-from handle empty: " << (!base ? "Yes" : "No") << endl;
+    cout << "After growing: " << handles[1]->getName() << " - R" << handles[1]->getPrice()
+         << " (same object: " << (handles[1].get() == decoratedPizza ? "Yes" : "No") << ")" << endl;
+    
+    // Releasing hands the pizza back to the caller
+    Pizza* released = handles[0].release();
+    cout << "Released: " << released->getName() << " (handle empty: " << (!handles[0] ? "Yes" : "No") << ")" << endl;
+    delete released;
+    
+    // Orders take handles and move between stages without cloning
+    PizzaOrders order(9108, "Handle Order");
+    order.addPizza(std::move(handles[1]));
+    order.addPizza(order.createMeatLoversPizza(true, false));
+    Money total = order.getTotalPrice();
+    size_t arenaBytes = order.getArenaBytesUsed();
+    
+    vector<PizzaOrders> pipeline;
+    pipeline.push_back(std::move(order));
+    pipeline.push_back(PizzaOrders(9109, "Second Order"));
+    PizzaOrders delivered(std::move(pipeline[0]));
+    cout << "Moved order: " << delivered.getPizzaCount() << " pizzas, R" << delivered.getTotalPrice()
+         << " (same total: " << (delivered.getTotalPrice() == total ? "Yes" : "No")
+         << ", same arena: " << (delivered.getArenaBytesUsed() == arenaBytes ? "Yes" : "No") << ")" << endl;
+    cout << "Moved-from order: " << pipeline[0].getPizzaCount() << " pizzas, state '"
+         << pipeline[0].getCurrentStateName() << "'" << endl;
+    
+    // A moved-from order can still be used
+    pipeline[0].addPizza(pipeline[0].createPepperoniPizza());
+    cout << "Reused order total: R" << pipeline[0].getTotalPrice() << endl;
+    
+    // Menus move with their pizzas
+    PizzaMenu menu("Handle Menu");
+    menu.addPizza(new BasePizza(ToppingGroup::createVegetarianDeluxePizza()));
+    PizzaMenu moved(std::move(menu));
+    cout << "Moved menu: " << moved.getPizzaCount() << " pizza (source " << menu.getPizzaCount() << ")" << endl;
+    cout << endl;
+}
+
+void testPizzaFingerprints() {
+    cout << "\n=== Testing Pizza Fingerprints ===" << endl;
+    
+    PizzaOrders order(9110, "Fingerprint Order");
+    CatalogSnapshot catalog = ToppingCatalog::current();
+    ToppingId pepperoni = catalog->findId("Pepperoni");
+    
+    // Same product built two ways
+    Pizza* menuPizza = order.createPepperoniPizza(true, false);
+    Pizza* customPizza = order.createCustomPizza({"Pepperoni"}, true, false);
+    cout << "Menu vs custom Pepperoni + Extra Cheese equal: "
+         << (menuPizza->getFingerprint() == customPizza->getFingerprint() ? "Yes" : "No") << endl;
+    
+    // Decorator order doesn't matter
+    Pizza* cheeseThenCrust = new StuffedCrust(new ExtraCheese(new BasePizza(ToppingGroup::createPepperoniPizza())));
+    Pizza* crustThenCheese = new ExtraCheese(new StuffedCrust(new BasePizza(ToppingGroup::createPepperoniPizza())));
+    cout << "Decorator order ignored: "
+         << (cheeseThenCrust->getFingerprint() == crustThenCheese->getFingerprint() ? "Yes" : "No") << endl;
+    
+    // A topping counted twice equals two separate nodes
+    ToppingGroup* counted = new ToppingGroup("Counted");
+    counted->addTopping(pepperoni, 2);
+    ToppingGroup* separate = new ToppingGroup("Separate");
+    separate->addComponent(new Topping("Pepperoni"));
+    separate->addComponent(new Topping("Pepperoni"));
+    cout << "Pepperoni x2 equals two nodes: "
+         << (counted->getFingerprint() == separate->getFingerprint() ? "Yes" : "No") << endl;
+    
+    // Different pizzas differ
+    Pizza* plain = new BasePizza(ToppingGroup::createPepperoniPizza());
+    cout << "Plain differs from Extra Cheese: "
+         << (plain->getFingerprint() != menuPizza->getFingerprint() ? "Yes" : "No") << endl;
+    
+    // Compile-time recipes carry the same fingerprint as a constant
+    static_assert(WithStuffedCrust<WithExtraCheese<StaticBase> >::fingerprint() ==
+                  WithExtraCheese<WithStuffedCrust<StaticBase> >::fingerprint(),
+                  "fingerprints ignore decorator order");
+    StaticPizza<WithExtraCheese<StaticPepperoni> > staticPizza;
+    cout << "Static recipe matches runtime pizza: "
+         << (staticPizza.getFingerprint() == menuPizza->getFingerprint() ? "Yes" : "No") << endl;
+    FrozenRecipe* frozen = FrozenRecipe::freeze(*cheeseThenCrust);
+    cout << "Frozen recipe matches: "
+         << (frozen != nullptr && frozen->getFingerprint() == cheeseThenCrust->getFingerprint() ? "Yes" : "No") << endl;
+    delete frozen;
+    
+    // Editing a nested group refreshes the cached fingerprints above it
+    ToppingGroup* outer = new ToppingGroup("Outer");
+    ToppingGroup* inner = new ToppingGroup("Inner");
+    outer->addComponent(inner);
+    inner->addTopping(pepperoni);
+    PizzaFingerprint before = outer->getFingerprint();
+    inner->addTopping(pepperoni);
+    cout << "Nested edit changes fingerprint: " << (outer->getFingerprint() != before ? "Yes" : "No")
+         << ", equals Pepperoni x2: " << (outer->getFingerprint() == counted->getFingerprint() ? "Yes" : "No") << endl;
+    
+    // Group identical pizzas, e.g. for the kitchen
+    unordered_map<PizzaFingerprint, int> identical;
+    identical[menuPizza->getFingerprint()]++;
+    identical[customPizza->getFingerprint()]++;
+    identical[plain->getFingerprint()]++;
+    cout << "Distinct products: " << identical.size() << " (of 3 pizzas)" << endl;
+    cout << "Fingerprint digits: " << plain->getFingerprint().toString().size() << endl;
+    
+    delete outer;
+    delete plain;
+    delete counted;
+    delete separate;
+    delete cheeseThenCrust;
+    delete crustThenCheese;
+    order.addPizza(menuPizza);
+    order.addPizza(customPizza);
+    cout << endl;
+}
+
+void testBatchPricing() {
+    cout << "\n=== Testing Batch Pricing ===" << endl;
+    // BEST depends on the CPU, so only its name is checked
+    string kernel = PriceBatch::bestKernelName();
+    cout << "Best kernel known: " << (kernel == "scalar" || kernel == "avx2" ? "Yes" : "No") << endl;
+    
+    // A mix of everything a batch can hold, including types it can't flatten
+    vector<Pizza*> pizzas;
+    for (int i = 0; i < 40; ++i) {
+        pizzas.push_back(new BasePizza(ToppingGroup::createMeatLoversPizza()));
+        pizzas.push_back(new StuffedCrust(new ExtraCheese(new BasePizza(ToppingGroup::createVegetarianDeluxePizza()))));
+        pizzas.push_back(new StaticDecorator<BasePizza, EXTRA_CHEESE>(new BasePizza(ToppingGroup::createPepperoniPizza())));
+    }
+    ToppingGroup* custom = new ToppingGroup("Custom");
+    custom->addTopping(ToppingCatalog::current()->findId("Olives"), 3);
+    custom->addComponent(new Topping("Truffle"));
+    pizzas.push_back(new ExtraCheese(new BasePizza(custom)));
+    pizzas.push_back(new StaticPizza<WithStuffedCrust<StaticVegetarian> >());
+    pizzas.push_back(new BasePizza(new ToppingGroup("Empty")));
+    
+    // Both kernels must give exactly the per-pizza prices
+    PriceBatch batch(pizzas.data(), pizzas.size());
+    auto matches = [&](const vector<Money>& prices) {
+        for (size_t i = 0; i < pizzas.size(); ++i) {
+            if (prices[i] != pizzas[i]->getPrice()) {
+                cout << "  Mismatch at " << i << ": " << prices[i] << " vs " << pizzas[i]->getPrice() << endl;
+                return false;
+            }
+        }
+        return true;
+    };
+    cout << "Batch of " << batch.size() << " (" << batch.getFallbackCount() << " priced one by one)" << endl;
+    cout << "Scalar kernel matches: " << (matches(batch.price(PriceBatch::SCALAR)) ? "Yes" : "No") << endl;
+    cout << "AVX2 kernel matches: " << (matches(batch.price(PriceBatch::AVX2)) ? "Yes" : "No") << endl;
+    cout << "Best kernel matches: " << (matches(batch.price()) ? "Yes" : "No") << endl;
+    
+    // The same batch reprices after the catalog changes
+    ToppingCatalog::registerTopping("Salami", Money::fromRands(40));
+    ToppingCatalog::registerModifier(EXTRA_CHEESE, Money::fromRands(15));
+    cout << "After repricing, matches: " << (matches(batch.price()) ? "Yes" : "No") << endl;
+    ToppingCatalog::resetToDefaults();
+    
+    // Frozen recipes price the same way
+    vector<FrozenRecipe*> recipes;
+    for (size_t i = 0; i < 6; ++i) {
+        recipes.push_back(FrozenRecipe::freeze(*pizzas[i]));
+    }
+    recipes.push_back(FrozenRecipe::freeze(*pizzas[pizzas.size() - 3]));
+    vector<Money> frozenPrices(recipes.size());
+    PriceBatch::priceAll(recipes.data(), recipes.size(), frozenPrices.data());
+    bool frozenMatch = true;
+    for (size_t i = 0; i < recipes.size(); ++i) {
+        frozenMatch = frozenMatch && frozenPrices[i] == recipes[i]->getPrice();
+    }
+    cout << "Frozen recipes match: " << (frozenMatch ? "Yes" : "No") << endl;
+    
+    for (FrozenRecipe* recipe : recipes) {
+        delete recipe;
+    }
+    for (Pizza* pizza : pizzas) {
+        delete pizza;
+    }
+    cout << endl;
+}
+
+// Sink that counts how often it is written to and flushed
+class CountingSink : public OutputSink {
+public:
+    string text;
+    int writes = 0;
+    int flushes = 0;
+    
+    void write(const char* data, size_t length) override {
+        text.append(data, length);
+        ++writes;
+    }
+    void flush() override {
+        ++flushes;
+    }
+};
+
+void testOutputSinks() {
+    cout << "\n=== Testing Output Sinks ===" << endl;
+    
+    PizzaOrders order(9120, "Receipt Order");
+    order.addPizza(order.createMeatLoversPizza(true, true));
+    order.addPizza(order.createVegetarianPizza());
+    order.setDiscountStrategy(new FamilyDiscount());
+    
+    // A whole receipt is one write and one flush
+    CountingSink counting;
+    order.displayOrder(counting);
+    cout << "Receipt: " << counting.writes << " write, " << counting.flushes << " flush, "
+         << count(counting.text.begin(), counting.text.end(), '\n') << " lines" << endl;
+    
+    // Same text whatever the sink
+    StringSink text;
+    order.displayOrder(text);
+    cout << "String sink matches: " << (text.str() == counting.text ? "Yes" : "No") << endl;
+    
+    text.clear();
+    order.getPizzas()[1]->printPizza(text);
+    cout << "Printed pizza: " << text.str();
+    
+    // Menus and observers can be redirected too; nothing reaches the console
+    StringSink board;
+    Customer customer("Sink Customer");
+    Website website;
+    customer.setOutputSink(board);
+    website.setOutputSink(board);
+    PizzaMenu menu("Board Menu");
+    menu.setOutputSink(board);
+    menu.addObserver(&customer);
+    menu.addObserver(&website);
+    menu.addPizza(new BasePizza(ToppingGroup::createPepperoniPizza()));
+    menu.displayMenu(board);
+    customer.displayNotifications(board);
+    cout << "Board lines: " << count(board.str().begin(), board.str().end(), '\n') << " (broadcast first: "
+         << (board.str().find("[PIZZA MENU NOTIFICATION]") < board.str().find("Customer Notification") ? "Yes" : "No")
+         << ")" << endl;
+    
+    // Bulk receipts into a file, one flush per receipt
+    const string receiptFile = "test_receipts.txt";
+    {
+        FileSink file(receiptFile);
+        for (int i = 0; i < 3; ++i) {
+            order.displayOrderSummary(file);
+        }
+    }
+    ifstream in(receiptFile.c_str());
+    string contents((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    remove(receiptFile.c_str());
+    size_t summaries = 0;
+    for (size_t at = contents.find("Order Summary"); at != string::npos; at = contents.find("Order Summary", at + 1)) {
+        ++summaries;
+    }
+    cout << "File sink summaries: " << summaries << endl;
+    
+    // File descriptors get the document on flush
+    FILE* temp = tmpfile();
+    if (temp != nullptr) {
+        {
+            FdSink descriptor(fileno(temp));
+            order.displayStateInfo(descriptor);
+        }
+        rewind(temp);
+        char line[64] = {0};
+        fgets(line, sizeof(line), temp);
+        fgets(line, sizeof(line), temp);
+        cout << "Fd sink: " << line;
+        fclose(temp);
+    }
+    cout << endl;
+}
+
+void testOrderTotals() {
+    cout << "\n=== Testing Running Order Totals ===" << endl;
+    
+    // Sum of the pizzas' own prices, the way the total used to be computed
+    auto walkedTotal = [](const PizzaOrders& order) {
+        CatalogScope scope(order.getPricingCatalog());
+        Money total;
+        for (Pizza* pizza : order.getPizzas()) {
+            total += pizza->getPrice();
+        }
+        return total;
+    };
+    
+    // A catering order with hundreds of lines
+    PizzaOrders order(9130, "Catering Order");
+    for (int i = 0; i < 200; ++i) {
+        order.addPizza(order.createMeatLoversPizza(i % 2 == 0, i % 5 == 0));
+        order.addPizza(order.createVegetarianPizza(false, i % 4 == 0));
+    }
+    cout << "Pizzas: " << order.getPizzaCount() << ", total R" << order.getTotalPrice()
+         << " (matches walk: " << (order.getTotalPrice() == walkedTotal(order) ? "Yes" : "No") << ")" << endl;
+    cout << "Extra Cheese: " << order.getModifierCount(EXTRA_CHEESE)
+         << ", Stuffed Crust: " << order.getModifierCount(STUFFED_CRUST)
+         << ", add-ons R" << order.getAddOnTotal() << endl;
+    
+    // Removing lines takes their price and add-ons off again
+    for (int i = 0; i < 50; ++i) {
+        order.removePizza(i);
+    }
+    order.removePizza(10000);
+    cout << "After removals: " << order.getPizzaCount() << ", R" << order.getTotalPrice()
+         << " (matches walk: " << (order.getTotalPrice() == walkedTotal(order) ? "Yes" : "No")
+         << "), Extra Cheese: " << order.getModifierCount(EXTRA_CHEESE) << endl;
+    
+    // Discounts read the same running total
+    order.setDiscountStrategy(new BulkDiscount());
+    cout << "Bulk discount: R" << order.getDiscountAmount() << ", final R" << order.getDiscountedTotal() << endl;
+    
+    // Copies and moves carry the totals
+    PizzaOrders copy(order);
+    PizzaOrders moved(std::move(copy));
+    cout << "Copied then moved: R" << moved.getTotalPrice() << " (source R" << copy.getTotalPrice() << ")" << endl;
+    
+    // A catalog refresh reprices every line once
+    ToppingCatalog::registerTopping("Salami", Money::fromRands(30));
+    ToppingCatalog::registerModifier(STUFFED_CRUST, Money::fromRands(25));
+    Money pinned = order.getTotalPrice();
+    order.refreshCatalog();
+    cout << "Refreshed: R" << pinned << " -> R" << order.getTotalPrice()
+         << " (matches walk: " << (order.getTotalPrice() == walkedTotal(order) ? "Yes" : "No") << ")" << endl;
+    ToppingCatalog::resetToDefaults();
+    
+    order.clearOrder();
+    cout << "Cleared: " << order.getPizzaCount() << " pizzas, R" << order.getTotalPrice()
+         << ", add-ons R" << order.getAddOnTotal() << endl;
+    cout << endl;
+}
+
+void testOrderPool() {
+    cout << "\n=== Testing Order Pool ===" << endl;
+    
+    OrderPool pool;
+    PizzaOrders* first;
+    {
+        PooledOrder order = pool.acquire(9140, "Pool Customer");
+        for (int i = 0; i < 20; ++i) {
+            order->addPizza(order->createMeatLoversPizza(true, false));
+        }
+        order->setDiscountStrategy(new FamilyDiscount());
+        order->performConfirmOrder();
+        first = order.get();
+        cout << "First order: " << order->getPizzaCount() << " pizzas, R" << order->getDiscountedTotal() << endl;
+    }
+    cout << "Idle after release: " << pool.getIdleCount() << " (retained " << (pool.getRetainedBytes() > 0 ? "some" : "no")
+         << " memory)" << endl;
+    cout << "Idle order pins a catalog: " << (first->getPricingCatalog() ? "Yes" : "No") << endl;
+    ToppingCatalog::registerTopping("Salami", Money::fromRands(30));
+    
+    // The next order reuses the object, fresh and in the Ordering state
+    {
+        PooledOrder order = pool.acquire(9141, "Next Customer");
+        cout << "Reused same object: " << (order.get() == first ? "Yes" : "No")
+             << ", #" << order->getOrderNumber() << " " << order->getOrderName()
+             << ", " << order->getPizzaCount() << " pizzas, state '" << order->getCurrentStateName()
+             << "', discount " << (order->getDiscountStrategy() == nullptr ? "none" : "set") << endl;
+        cout << "Priced with the latest catalog: "
+             << (order->getCatalogVersion() == ToppingCatalog::current()->getVersion() ? "Yes" : "No") << endl;
+        ToppingCatalog::resetToDefaults();
+        order->refreshCatalog();
+        size_t before = order->getRetainedBytes();
+        order->addPizza(order->createPepperoniPizza());
+        cout << "No new memory for a small order: " << (order->getRetainedBytes() == before ? "Yes" : "No")
+             << ", total R" << order->getTotalPrice() << endl;
+        
+        // Leases move; the order goes back once
+        PooledOrder moved(std::move(order));
+        cout << "Moved lease empty: " << (!order ? "Yes" : "No") << endl;
+    }
+    
+    // Several at once: one hit, the rest misses
+    {
+        vector<PooledOrder> orders;
+        for (int i = 0; i < 3; ++i) {
+            orders.push_back(pool.acquire(9150 + i, "Busy"));
+        }
+    }
+    OrderPool::Stats stats = pool.getStats();
+    cout << "Hits: " << stats.hits << ", misses: " << stats.misses << ", returned: " << stats.returned
+         << ", hit rate: " << static_cast<int>(stats.hitRate() * 100 + 0.5) << "%" << endl;
+    
+    // Lowering the cap drops idle orders, and releases that don't fit are discarded
+    pool.setRetainedLimit(0);
+    cout << "Idle with no cap room: " << pool.getIdleCount() << ", retained " << pool.getRetainedBytes() << " bytes" << endl;
+    {
+        PooledOrder order = pool.acquire(9160, "Capped");
+    }
+    cout << "Discarded: " << pool.getStats().discarded << ", idle " << pool.getIdleCount() << endl;
+    
+    // Each thread has its own pool
+    OrderPool* mainPool = &OrderPool::local();
+    OrderPool* otherPool = nullptr;
+    thread worker([&otherPool]() {
+        otherPool = &OrderPool::local();
+        PooledOrder order = OrderPool::local().acquire(9170, "Worker");
+    });
+    worker.join();
+    cout << "Thread-local pools differ: " << (mainPool != otherPool ? "Yes" : "No") << endl;
+    cout << endl;
+}
+
+void testSharedStates() {
+    cout << "\n=== Testing Shared Order States ===" << endl;
+    
+    // Transitions move orders between the shared instances; nothing is allocated
+    PizzaOrders first(9180, "Shared A");
+    PizzaOrders second(9181, "Shared B");
+    first.addPizza(first.createPepperoniPizza());
+    second.addPizza(second.createVegetarianPizza());
+    cout << "Both start in the shared Ordering state: "
+         << (first.getCurrentState() == &OrderingState::instance() && second.getCurrentState() == first.getCurrentState() ? "Yes" : "No") << endl;
+    
+    first.performConfirmOrder();
+    second.performConfirmOrder();
+    cout << "Both confirmed share one instance: "
+         << (first.getCurrentState() == &ConfirmedState::instance() && second.getCurrentState() == first.getCurrentState() ? "Yes" : "No")
+         << " (" << first.getCurrentStateName() << ")" << endl;
+    
+    // A state handed over with new is still adopted and deleted by the order
+    second.setState(new PaidState());
+    cout << "Adopted state: " << second.getCurrentStateName()
+         << ", shared: " << (second.getCurrentState() == &PaidState::instance() ? "Yes" : "No") << endl;
+    PizzaOrders third(9182, "Shared C");
+    third.setState(new PaidState());
+    third.performPrepareOrder();
+    cout << "Back on a shared instance: " << (third.getCurrentState() == &PreparingState::instance() ? "Yes" : "No") << endl;
+    
+    // A moved order keeps its state; the adopted one is deleted exactly once
+    PizzaOrders moved(std::move(first));
+    PizzaOrders movedAdopted(std::move(second));
+    cout << "Moved: " << moved.getCurrentStateName() << ", " << movedAdopted.getCurrentStateName() << endl;
+    moved.performCancelOrder();
+    cout << "Cancelled moved order: " << moved.getCurrentStateName() << endl;
+    cout << endl;
+}
+
+void testOrderLifecycleTable() {
+    cout << "\n=== Testing Order Lifecycle Table ===" << endl;
+    
+    // The table can be read at compile time
+    static_assert(OrderLifecycle::next(PAID, PREPARE_ORDER) == PREPARING, "Paid orders go to Preparing");
+    static_assert(OrderLifecycle::next(COMPLETED, CANCEL_ORDER) == COMPLETED, "Completed orders stay completed");
+    cout << "Confirmed + pay -> " << OrderLifecycle::STATUSES[OrderLifecycle::next(CONFIRMED, PAY_ORDER)].name << endl;
+    
+    // Dispatching one event, with the messages in a sink
+    StringSink messages;
+    PizzaOrders order(9190, "Table");
+    cout << "Confirm empty order moved: " << (OrderLifecycle::dispatch(order, CONFIRM_ORDER, 0, messages) ? "Yes" : "No") << endl;
+    order.addPizza(order.createPepperoniPizza());
+    order.addPizza(order.createVegetarianPizza());
+    cout << "Remove bad index moved: " << (OrderLifecycle::dispatch(order, REMOVE_PIZZA, 5, messages) ? "Yes" : "No") << endl;
+    OrderLifecycle::dispatch(order, REMOVE_PIZZA, 1, messages);
+    cout << "Confirm moved: " << (OrderLifecycle::dispatch(order, CONFIRM_ORDER, 0, messages) ? "Yes" : "No")
+         << ", now " << order.getCurrentStateName() << " with " << order.getPizzaCount() << " pizza" << endl;
+    cout << "Add after confirming moved: " << (OrderLifecycle::dispatch(order, ADD_PIZZA, 0, messages) ? "Yes" : "No") << endl;
+    cout << "Messages:\n" << messages.str();
+    
+    // Several events written into one document the caller holds
+    messages.clear();
+    {
+        Document document(messages);
+        OrderLifecycle::dispatch(order, PAY_ORDER, 0, document);
+        OrderLifecycle::dispatch(order, PREPARE_ORDER, 0, document);
+        cout << "Nothing written before the document ends: " << (messages.str().empty() ? "Yes" : "No") << endl;
+    }
+    cout << "Now " << order.getCurrentStateName() << ", messages:\n" << messages.str();
+    
+    // One event for many orders; orders it doesn't apply to stay put
+    vector<PizzaOrders*> orders;
+    for (int i = 0; i < 4; ++i) {
+        orders.push_back(new PizzaOrders(9200 + i, "Bulk"));
+        orders.back()->addPizza(orders.back()->createPepperoniPizza());
+    }
+    orders[3]->performCancelOrder();
+    orders.push_back(nullptr);
+    messages.clear();
+    size_t moved = OrderLifecycle::apply(CONFIRM_ORDER, orders.data(), orders.size(), messages);
+    moved += OrderLifecycle::apply(PAY_ORDER, orders.data(), 2, messages);
+    cout << "Moved by apply: " << moved << endl;
+    for (PizzaOrders* bulk : orders) {
+        if (bulk != nullptr) {
+            cout << "  #" << bulk->getOrderNumber() << ": " << bulk->getCurrentStateName() << endl;
+            delete bulk;
+        }
+    }
+    cout << "Bulk messages:\n" << messages.str();
+    cout << endl;
+}
+
+void testOrderRegistry() {
+    cout << "\n=== Testing Order Registry ===" << endl;
+    
+    OrderRegistry registry(10, 5000);
+    cout << "Shards: " << registry.getShardCount() << endl;
+    
+    StringSink messages;
+    RegisteredOrder first = registry.create("Registry A");
+    RegisteredOrder second = registry.create("Registry B");
+    cout << "Numbers: " << first.getOrderNumber() << ", " << second.getOrderNumber() << ", live " << registry.size() << endl;
+    
+    first.withOrder([](PizzaOrders& order) { order.addPizza(order.createPepperoniPizza()); });
+    RegisteredOrder found = registry.find(first.getOrderNumber());
+    cout << "Found: " << (found ? found.withOrder([](PizzaOrders& order) { return order.getOrderName(); }) : "nothing")
+         << ", missing found: " << (registry.find(4999) ? "Yes" : "No") << endl;
+    cout << "Confirm moved: " << (registry.transition(first.getOrderNumber(), CONFIRM_ORDER, 0, messages) ? "Yes" : "No")
+         << ", pay through handle moved: " << (found.dispatch(PAY_ORDER, 0, messages) ? "Yes" : "No")
+         << ", unknown order moved: " << (registry.transition(4999, CANCEL_ORDER, 0, messages) ? "Yes" : "No") << endl;
+    cout << "State seen by first handle: " << first.withOrder([](PizzaOrders& order) { return order.getCurrentStateName(); }) << endl;
+    
+    // Retiring drops the order from the registry; handles keep it alive
+    cout << "Retired: " << (registry.retire(first.getOrderNumber()) ? "Yes" : "No")
+         << ", again: " << (registry.retire(first.getOrderNumber()) ? "Yes" : "No")
+         << ", handle sees retired: " << (first.isRetired() ? "Yes" : "No")
+         << ", still contains: " << (registry.contains(first.getOrderNumber()) ? "Yes" : "No")
+         << ", live " << registry.size() << endl;
+    cout << "Retired order still readable: " << first.withOrder([](PizzaOrders& order) { return order.getPizzaCount(); }) << " pizza" << endl;
+    
+    // Many threads creating, transitioning and retiring at once
+    const int threads = 4;
+    const int perThread = 200;
+    vector<vector<int>> numbers(threads);
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(thread([&registry, &numbers, t, perThread]() {
+            StringSink threadMessages;
+            for (int i = 0; i < perThread; ++i) {
+                RegisteredOrder order = registry.create("Worker");
+                numbers[t].push_back(order.getOrderNumber());
+                registry.transition(order.getOrderNumber(), i % 2 == 0 ? CANCEL_ORDER : CONFIRM_ORDER, 0, threadMessages);
+                if (i % 2 == 0) {
+                    registry.retire(order.getOrderNumber());
+                }
+            }
+        }));
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    vector<int> all;
+    for (const vector<int>& list : numbers) {
+        all.insert(all.end(), list.begin(), list.end());
+    }
+    sort(all.begin(), all.end());
+    cout << "Unique numbers: " << (adjacent_find(all.begin(), all.end()) == all.end() ? "Yes" : "No")
+         << ", live after threads: " << registry.size() << endl;
+    size_t ordering = 0;
+    for (int number : all) {
+        RegisteredOrder order = registry.find(number);
+        if (order && order.withOrder([](PizzaOrders& o) { return o.getCurrentStateName(); }) == "Ordering") {
+            ++ordering;
+        }
+    }
+    cout << "Live orders still Ordering: " << ordering << endl;
+    cout << endl;
+}
+
 // Main function to run all additional tests
 void runAdditionalCoverageTests() {
     cout << "\n" << string(60, '=') << endl;
@@ -1606,6 +3093,31 @@ void runAdditionalCoverageTests() {
         testToppingEdgeCases();
         testEmptyToppingGroupOperations();
         testFactoryMethodsDetailedOutput();
+        testToppingCatalogIds();
+        testCatalogHotReload();
+        testCatalogImage();
+        testToppingFlyweights();
+        testMoneyArithmetic();
+        testToppingGroupPriceCache();
+        testNameRenderer();
+        testFrozenRecipes();
+        testOrderArena();
+        testCopyOnWriteGroups();
+        testComponentClone();
+        testRecipeRegistry();
+        testStaticRecipes();
+        testToppingQuantities();
+        testModifierSet();
+        testStaticDecorators();
+        testPizzaHandles();
+    testPizzaFingerprints();
+    testBatchPricing();
+    testOutputSinks();
+    testOrderTotals();
+    testOrderPool();
+    testSharedStates();
+    testOrderLifecycleTable();
+    testOrderRegistry();
         
         cout << "\n" << string(60, '=') << endl;
         cout << "    ALL ADDITIONAL COVERAGE TESTS COMPLETED SUCCESSFULLY" << endl;
@@ -2028,10 +3540,13 @@ void valgrind(){
 // Updated main function
 int main() {
     
+    // Recipes are data; the defaults are used if the file is missing
+    RecipeRegistry::loadFromFile("recipes.txt");
+    
     functions();
     //statePattern();
 
     //valgrind();
     
     return 0;
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -1,54 +1,118 @@
 #include "Topping.h"
+#include "PizzaName.h"
 #include <iostream>
 
-// Initialize the static map with predefined topping prices
-std::map<std::string, double> Topping::toppingPrices = Topping::initializeToppingPrices();
-
-std::map<std::string, double> Topping::initializeToppingPrices() {
-    std::map<std::string, double> prices;
-    
-    // Base ingredients
-    prices["Dough"] = 10.00;
-    prices["Tomato Sauce"] = 5.00;
-    prices["Cheese"] = 15.00;
-    
-    // Toppings
-    prices["Pepperoni"] = 20.00;
-    prices["Mushrooms"] = 12.00;
-    prices["Green Peppers"] = 10.00;
-    prices["Onions"] = 8.00;
-    prices["Beef Sausage"] = 25.00;
-    prices["Salami"] = 22.00;
-    prices["Feta Cheese"] = 18.00;
-    prices["Olives"] = 15.00;
-    
-    return prices;
-}
-
-Topping::Topping(const std::string& toppingName) {
-    auto it = toppingPrices.find(toppingName);
-    if (it != toppingPrices.end()) {
-        this->name = toppingName;
-        this->price = it->second;
-    } else {
+Topping::Topping(const std::string& toppingName, unsigned portions)
+    : toppingId(ToppingCatalog::current()->findId(toppingName)), quantity(portions), shared(false) {
+    if (toppingId == ToppingCatalog::INVALID_ID) {
         std::cerr << "Warning: Unknown topping '" << toppingName << "'. Using default values." << std::endl;
+        // Only unknown toppings keep their own name, known ones read it from the catalog
         this->name = toppingName;
-        this->price = 0.0;
+        this->price = Money();
+    }
+}
+
+Topping::Topping(ToppingId id, unsigned portions) : toppingId(id), quantity(portions), shared(false) {
+    if (!ToppingCatalog::current()->isValidId(id)) {
+        std::cerr << "Warning: Unknown topping ID " << id << ". Using default values." << std::endl;
+        this->toppingId = ToppingCatalog::INVALID_ID;
+        this->price = Money();
     }
 }
 
+Topping::Topping(ToppingId id, InternTag) : toppingId(id), quantity(1), shared(true) {
+}
+
+Topping::Topping(const Topping& other)
+    : PizzaComponent(other.price, other.name), toppingId(other.toppingId), quantity(other.quantity), shared(false) {
+}
+
+Topping& Topping::operator=(const Topping& other) {
+    if (this != &other) {
+        this->name = other.name;
+        this->price = other.price;
+        this->toppingId = other.toppingId;
+        this->quantity = other.quantity;
+    }
+    return *this;
+}
+
 std::string Topping::getName() const {
+    if (quantity <= 1) {
+        return getToppingName();
+    }
+    return renderName(*this);
+}
+
+std::string Topping::getToppingName() const {
+    if (toppingId != ToppingCatalog::INVALID_ID) {
+        CatalogScope scope;
+        return scope.catalog().getName(toppingId);
+    }
     return name;
 }
 
-double Topping::getPrice() const {
-    return price;
+void Topping::writeName(NameWriter& out) const {
+    if (toppingId != ToppingCatalog::INVALID_ID) {
+        // Copy straight out of the catalog's name table
+        CatalogScope scope;
+        size_t length = 0;
+        const char* data = scope.catalog().getNameData(toppingId, length);
+        out.append(data, length);
+    } else {
+        out.append(name);
+    }
+    if (quantity > 1) {
+        out.append(" x");
+        out.appendNumber(quantity);
+    }
+}
+
+Money Topping::getPrice() const {
+    if (toppingId != ToppingCatalog::INVALID_ID) {
+        // Price comes from the snapshot active on this thread, not a copy made at construction
+        CatalogScope scope;
+        return scope.catalog().getPrice(toppingId) * quantity;
+    }
+    return price * quantity;
+}
+
+PizzaFingerprint Topping::getFingerprint() const {
+    if (toppingId != ToppingCatalog::INVALID_ID) {
+        return PizzaFingerprint::ofTopping(toppingId, quantity);
+    }
+    return PizzaFingerprint::ofTopping(name.data(), name.size(), quantity);
+}
+
+bool Topping::isShared() const {
+    return shared;
+}
+
+PizzaComponent::Kind Topping::getKind() const {
+    return TOPPING;
+}
+
+PizzaComponent* Topping::cloneInto(MemoryResource& resource) const {
+    return new (resource) Topping(*this);
+}
+
+ToppingId Topping::getId() const {
+    return toppingId;
+}
+
+unsigned Topping::getQuantity() const {
+    return quantity;
+}
+
+const Topping* Topping::intern(ToppingId id) {
+    CatalogScope scope;
+    return scope.catalog().getTopping(id);
 }
 
 bool Topping::isValidTopping(const std::string& toppingName) {
-    return toppingPrices.find(toppingName) != toppingPrices.end();
+    return ToppingCatalog::current()->findId(toppingName) != ToppingCatalog::INVALID_ID;
 }
 
-std::map<std::string, double> Topping::getAllToppings() {
-    return toppingPrices;
-}
\ No newline at end of file
+std::map<std::string, Money> Topping::getAllToppings() {
+    return ToppingCatalog::current()->toMap();
+}
@@ -2,30 +2,62 @@
 #define TOPPING_H
 
 #include "PizzaComponent.h"
+#include "ToppingCatalog.h"
 #include <string>
 #include <map>
 
 class Topping : public PizzaComponent {
 private:
-    // Static map to store predefined topping prices
-    static std::map<std::string, double> toppingPrices;
+    // Catalog ID of this topping (ToppingCatalog::INVALID_ID for unknown names)
+    ToppingId toppingId;
     
-    // Static method to initialize the price map
-    static std::map<std::string, double> initializeToppingPrices();
+    // Number of portions (priced per portion, named "Pepperoni x2" above one)
+    unsigned quantity;
+    
+    // True for the interned instance owned by the catalog
+    bool shared;
+    
+    // Only the catalog creates interned instances
+    struct InternTag {};
+    Topping(ToppingId id, InternTag);
+    friend class ToppingCatalog;
 
 public:
-    // Constructor with topping name (price is looked up automatically)
-    Topping(const std::string& toppingName);
+    // Constructor with topping name (the name is resolved to a catalog ID once)
+    Topping(const std::string& toppingName, unsigned portions = 1);
+    
+    // Constructor with a catalog ID (no name lookup)
+    explicit Topping(ToppingId id, unsigned portions = 1);
+    
+    // Copies are always privately owned, even when copied from an interned topping
+    Topping(const Topping& other);
+    Topping& operator=(const Topping& other);
     
     // Override virtual methods
     std::string getName() const override;
-    double getPrice() const override;
+    void writeName(NameWriter& out) const override;
+    Money getPrice() const override;
+    PizzaFingerprint getFingerprint() const override;
+    bool isShared() const override;
+    Kind getKind() const override;
+    PizzaComponent* cloneInto(MemoryResource& resource) const override;
+    
+    // Get the catalog ID of this topping
+    ToppingId getId() const;
+    
+    // Number of portions, and the name of one portion (getName() adds the count)
+    unsigned getQuantity() const;
+    std::string getToppingName() const;
+    
+    // Immutable interned topping for a catalog ID, shared by every pizza that
+    // uses it. Returns nullptr if the ID is unknown to the active catalog.
+    static const Topping* intern(ToppingId id);
     
     // Static method to check if a topping exists
     static bool isValidTopping(const std::string& toppingName);
     
     // Static method to get all available toppings
-    static std::map<std::string, double> getAllToppings();
+    static std::map<std::string, Money> getAllToppings();
 };
 
-#endif
\ No newline at end of file
+#endif
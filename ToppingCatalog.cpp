@@ -0,0 +1,449 @@
+#include "ToppingCatalog.h"
+#include "CatalogImage.h"
+#include "Topping.h"
+#include <fstream>
+#include <iostream>
+#include <mutex>
+
+namespace {
+    // Readers that have loaded the published pointer but not pinned it yet.
+    // A writer only frees retired snapshots when this is zero, so a snapshot
+    // can't disappear between a reader loading it and pinning it.
+    std::atomic<int> readersPinning(0);
+
+    // Writers are serialised; readers never touch this
+    std::mutex& writerMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    // Snapshots replaced by a newer version, freed once unpinned (writer side only).
+    // Whatever is still retired at shutdown is freed with the list.
+    struct RetiredList {
+        std::vector<ToppingCatalog*> snapshots;
+        ~RetiredList() {
+            for (ToppingCatalog* snapshot : snapshots) {
+                delete snapshot;
+            }
+        }
+    };
+
+    std::vector<ToppingCatalog*>& retiredSnapshots() {
+        static RetiredList retired;
+        return retired.snapshots;
+    }
+
+    // Interned toppings, one per ID ever assigned. IDs are never reused, so
+    // this only grows and each entry lives until shutdown.
+    std::vector<std::unique_ptr<const Topping> >& internedToppings() {
+        static std::vector<std::unique_ptr<const Topping> > toppings;
+        return toppings;
+    }
+
+    // Snapshots are built by writers and by the first reader to touch the
+    // catalog, so interning has its own lock
+    std::mutex& internMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    // Snapshot selected by the innermost CatalogScope on this thread
+    thread_local const ToppingCatalog* activeCatalog = nullptr;
+
+    std::string trim(const std::string& text) {
+        size_t first = text.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos) {
+            return "";
+        }
+        size_t last = text.find_last_not_of(" \t\r\n");
+        return text.substr(first, last - first + 1);
+    }
+}
+
+const ToppingId ToppingCatalog::INVALID_ID;
+constexpr DefaultTopping ToppingCatalog::DEFAULT_TOPPINGS[];
+constexpr size_t ToppingCatalog::DEFAULT_TOPPING_COUNT;
+constexpr DefaultTopping ToppingCatalog::DEFAULT_MODIFIERS[];
+
+// ==================== Snapshot construction ====================
+
+ToppingCatalog::ToppingCatalog()
+    : version(1), priceTable(nullptr), toppingCount(0), defaultPrices(false), pins(0) {
+    for (const DefaultTopping& topping : DEFAULT_TOPPINGS) {
+        setTopping(topping.name, Money::fromCents(topping.cents));
+    }
+    for (size_t i = 0; i < PIZZA_MODIFIER_COUNT; ++i) {
+        modifierPrices[i] = DEFAULT_MODIFIERS[i].cents;
+    }
+    syncTables();
+}
+
+ToppingCatalog::ToppingCatalog(const ToppingCatalog& previous, unsigned long newVersion)
+    : names(previous.names), prices(previous.prices), available(previous.available),
+      ids(previous.ids), version(newVersion), priceTable(nullptr), toppingCount(0), defaultPrices(false), pins(0) {
+    if (previous.image) {
+        // Writers work on in-memory arrays, so copy the image's toppings out
+        for (size_t i = 0; i < previous.toppingCount; ++i) {
+            ToppingId id = static_cast<ToppingId>(i);
+            names.push_back(previous.getName(id));
+            prices.push_back(previous.priceTable[i]);
+            available.push_back(previous.isAvailable(id) ? 1 : 0);
+            ids[names.back()] = id;
+        }
+    }
+    for (size_t i = 0; i < PIZZA_MODIFIER_COUNT; ++i) {
+        modifierPrices[i] = previous.modifierPrices[i];
+    }
+    syncTables();
+}
+
+ToppingId ToppingCatalog::setTopping(const std::string& toppingName, Money toppingPrice) {
+    auto it = ids.find(toppingName);
+    if (it != ids.end()) {
+        prices[it->second] = toppingPrice.getCents();
+        available[it->second] = 1;
+        return it->second;
+    }
+
+    ToppingId id = static_cast<ToppingId>(names.size());
+    names.push_back(toppingName);
+    prices.push_back(toppingPrice.getCents());
+    available.push_back(1);
+    ids[toppingName] = id;
+    return id;
+}
+
+void ToppingCatalog::markAllUnavailable() {
+    for (size_t i = 0; i < available.size(); ++i) {
+        available[i] = 0;
+    }
+}
+
+ToppingCatalog::ToppingCatalog(const std::shared_ptr<const CatalogImage>& catalogImage, unsigned long newVersion)
+    : version(newVersion), image(catalogImage), priceTable(catalogImage->getPriceTable()),
+      toppingCount(catalogImage->getToppingCount()), defaultPrices(false), pins(0) {
+    // Images only hold toppings; installImage() carries the modifier prices over
+    for (size_t i = 0; i < PIZZA_MODIFIER_COUNT; ++i) {
+        modifierPrices[i] = DEFAULT_MODIFIERS[i].cents;
+    }
+}
+
+void ToppingCatalog::syncTables() {
+    if (!image) {
+        priceTable = prices.empty() ? nullptr : prices.data();
+        toppingCount = prices.size();
+    }
+
+    std::lock_guard<std::mutex> lock(internMutex());
+    std::vector<std::unique_ptr<const Topping> >& interned = internedToppings();
+    while (interned.size() < toppingCount) {
+        ToppingId id = static_cast<ToppingId>(interned.size());
+        interned.push_back(std::unique_ptr<const Topping>(new Topping(id, Topping::InternTag())));
+    }
+
+    leaves.resize(toppingCount);
+    for (size_t i = 0; i < toppingCount; ++i) {
+        leaves[i] = interned[i].get();
+    }
+
+    defaultPrices = toppingCount >= DEFAULT_TOPPING_COUNT;
+    for (size_t i = 0; i < DEFAULT_TOPPING_COUNT && defaultPrices; ++i) {
+        defaultPrices = priceTable[i] == DEFAULT_TOPPINGS[i].cents;
+    }
+    for (size_t i = 0; i < PIZZA_MODIFIER_COUNT && defaultPrices; ++i) {
+        defaultPrices = modifierPrices[i] == DEFAULT_MODIFIERS[i].cents;
+    }
+}
+
+// ==================== Publishing ====================
+
+std::atomic<const ToppingCatalog*>& ToppingCatalog::published() {
+    // Function-local static so the default catalog exists before first use
+    static std::atomic<const ToppingCatalog*> slot(new ToppingCatalog());
+    return slot;
+}
+
+const ToppingCatalog* ToppingCatalog::pinLatest() {
+    readersPinning.fetch_add(1);
+    const ToppingCatalog* latest = published().load();
+    latest->pins.fetch_add(1);
+    readersPinning.fetch_sub(1);
+    return latest;
+}
+
+void ToppingCatalog::publish(ToppingCatalog* next) {
+    // Caller holds writerMutex()
+    next->syncTables();
+    const ToppingCatalog* old = published().exchange(next);
+    std::vector<ToppingCatalog*>& retired = retiredSnapshots();
+    retired.push_back(const_cast<ToppingCatalog*>(old));
+
+    // A reader that loaded an old pointer is either still counted in
+    // readersPinning or has already pinned it
+    if (readersPinning.load() != 0) {
+        return;
+    }
+    for (size_t i = 0; i < retired.size();) {
+        if (retired[i]->pins.load() == 0) {
+            delete retired[i];
+            retired[i] = retired.back();
+            retired.pop_back();
+        } else {
+            ++i;
+        }
+    }
+}
+
+CatalogSnapshot ToppingCatalog::current() {
+    if (activeCatalog != nullptr) {
+        activeCatalog->pins.fetch_add(1);
+        return CatalogSnapshot(activeCatalog);
+    }
+    return CatalogSnapshot(pinLatest());
+}
+
+bool ToppingCatalog::loadFromFile(const std::string& path) {
+    std::ifstream file(path.c_str());
+    if (!file) {
+        std::cerr << "Error: Could not open topping catalog '" << path << "'." << std::endl;
+        return false;
+    }
+
+    // Parse everything first so a bad file never replaces a good catalog
+    std::vector<std::pair<std::string, Money> > entries;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        size_t comma = line.rfind(',');
+        std::string toppingName = comma == std::string::npos ? "" : trim(line.substr(0, comma));
+        std::string priceText = comma == std::string::npos ? "" : trim(line.substr(comma + 1));
+        Money toppingPrice;
+        if (toppingName.empty() || !Money::parse(priceText, toppingPrice) || toppingPrice < Money()) {
+            std::cerr << "Error: Invalid catalog entry on line " << lineNumber
+                      << " of '" << path << "'." << std::endl;
+            return false;
+        }
+        entries.push_back(std::make_pair(toppingName, toppingPrice));
+    }
+
+    std::lock_guard<std::mutex> lock(writerMutex());
+    const ToppingCatalog* latest = published().load();
+    ToppingCatalog* next = new ToppingCatalog(*latest, latest->version + 1);
+
+    // Toppings that are not in the file keep their ID but become unavailable
+    next->markAllUnavailable();
+    for (const auto& entry : entries) {
+        next->setTopping(entry.first, entry.second);
+    }
+
+    publish(next);
+    return true;
+}
+
+ToppingId ToppingCatalog::registerTopping(const std::string& toppingName, Money toppingPrice) {
+    std::lock_guard<std::mutex> lock(writerMutex());
+    const ToppingCatalog* latest = published().load();
+    ToppingCatalog* next = new ToppingCatalog(*latest, latest->version + 1);
+    ToppingId id = next->setTopping(toppingName, toppingPrice);
+    publish(next);
+    return id;
+}
+
+void ToppingCatalog::registerModifier(PizzaModifier modifier, Money modifierPrice) {
+    if (modifier >= PIZZA_MODIFIER_COUNT) {
+        std::cerr << "Error: Unknown pizza modifier." << std::endl;
+        return;
+    }
+    std::lock_guard<std::mutex> lock(writerMutex());
+    const ToppingCatalog* latest = published().load();
+    ToppingCatalog* next = new ToppingCatalog(*latest, latest->version + 1);
+    next->modifierPrices[modifier] = modifierPrice.getCents();
+    publish(next);
+}
+
+void ToppingCatalog::resetToDefaults() {
+    std::lock_guard<std::mutex> lock(writerMutex());
+    const ToppingCatalog* latest = published().load();
+    ToppingCatalog defaults;
+    ToppingCatalog* next = new ToppingCatalog(*latest, latest->version + 1);
+
+    next->markAllUnavailable();
+    for (size_t i = 0; i < defaults.names.size(); ++i) {
+        next->setTopping(defaults.names[i], Money::fromCents(defaults.prices[i]));
+    }
+    for (size_t i = 0; i < PIZZA_MODIFIER_COUNT; ++i) {
+        next->modifierPrices[i] = DEFAULT_MODIFIERS[i].cents;
+    }
+
+    publish(next);
+}
+
+bool ToppingCatalog::installImage(const std::shared_ptr<const CatalogImage>& catalogImage) {
+    if (!catalogImage) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(writerMutex());
+    const ToppingCatalog* latest = published().load();
+
+    // Toppings already handed out must keep meaning the same thing
+    uint32_t imageCount = catalogImage->getToppingCount();
+    if (imageCount < latest->toppingCount) {
+        std::cerr << "Error: Catalog image has fewer toppings than the current catalog." << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < latest->toppingCount; ++i) {
+        if (catalogImage->getToppingName(static_cast<uint32_t>(i)).str() != latest->getName(static_cast<ToppingId>(i))) {
+            std::cerr << "Error: Catalog image assigns a different ID to '"
+                      << latest->getName(static_cast<ToppingId>(i)) << "'." << std::endl;
+            return false;
+        }
+    }
+
+    ToppingCatalog* next = new ToppingCatalog(catalogImage, latest->version + 1);
+    for (size_t i = 0; i < PIZZA_MODIFIER_COUNT; ++i) {
+        next->modifierPrices[i] = latest->modifierPrices[i];
+    }
+    publish(next);
+    return true;
+}
+
+// ==================== Snapshot accessors ====================
+
+ToppingId ToppingCatalog::findId(const std::string& toppingName) const {
+    if (image) {
+        return image->findTopping(toppingName);
+    }
+    auto it = ids.find(toppingName);
+    if (it != ids.end() && available[it->second]) {
+        return it->second;
+    }
+    return INVALID_ID;
+}
+
+std::string ToppingCatalog::getName(ToppingId id) const {
+    if (!isValidId(id)) {
+        return "";
+    }
+    if (image) {
+        return image->getToppingName(static_cast<uint32_t>(id)).str();
+    }
+    return names[id];
+}
+
+const char* ToppingCatalog::getNameData(ToppingId id, size_t& length) const {
+    length = 0;
+    if (!isValidId(id)) {
+        return nullptr;
+    }
+    if (image) {
+        ImageString imageName = image->getToppingName(static_cast<uint32_t>(id));
+        length = imageName.length;
+        return imageName.data;
+    }
+    length = names[id].size();
+    return names[id].data();
+}
+
+bool ToppingCatalog::isAvailable(ToppingId id) const {
+    if (!isValidId(id)) {
+        return false;
+    }
+    if (image) {
+        return image->isToppingAvailable(static_cast<uint32_t>(id));
+    }
+    return available[id] != 0;
+}
+
+size_t ToppingCatalog::size() const {
+    return toppingCount;
+}
+
+unsigned long ToppingCatalog::getVersion() const {
+    return version;
+}
+
+bool ToppingCatalog::hasDefaultPrices() const {
+    return defaultPrices;
+}
+
+std::shared_ptr<const CatalogImage> ToppingCatalog::getImage() const {
+    return image;
+}
+
+std::map<std::string, Money> ToppingCatalog::toMap() const {
+    std::map<std::string, Money> result;
+    for (size_t i = 0; i < toppingCount; ++i) {
+        ToppingId id = static_cast<ToppingId>(i);
+        if (isAvailable(id)) {
+            result[getName(id)] = Money::fromCents(priceTable[i]);
+        }
+    }
+    return result;
+}
+
+// ==================== CatalogSnapshot ====================
+
+CatalogSnapshot::CatalogSnapshot() : catalog(nullptr) {
+}
+
+CatalogSnapshot::CatalogSnapshot(const ToppingCatalog* pinnedCatalog) : catalog(pinnedCatalog) {
+}
+
+CatalogSnapshot::~CatalogSnapshot() {
+    release();
+}
+
+CatalogSnapshot::CatalogSnapshot(const CatalogSnapshot& other) : catalog(other.catalog) {
+    if (catalog != nullptr) {
+        catalog->pins.fetch_add(1);
+    }
+}
+
+CatalogSnapshot& CatalogSnapshot::operator=(const CatalogSnapshot& other) {
+    if (this != &other) {
+        if (other.catalog != nullptr) {
+            other.catalog->pins.fetch_add(1);
+        }
+        release();
+        catalog = other.catalog;
+    }
+    return *this;
+}
+
+void CatalogSnapshot::release() {
+    if (catalog != nullptr) {
+        catalog->pins.fetch_sub(1);
+        catalog = nullptr;
+    }
+}
+
+// ==================== CatalogScope ====================
+
+CatalogScope::CatalogScope() : previous(activeCatalog), pinned(nullptr) {
+    if (activeCatalog == nullptr) {
+        pinned = ToppingCatalog::pinLatest();
+        activeCatalog = pinned;
+    }
+}
+
+CatalogScope::CatalogScope(const CatalogSnapshot& snapshot) : previous(activeCatalog), pinned(nullptr) {
+    activeCatalog = snapshot.get();
+}
+
+CatalogScope::~CatalogScope() {
+    activeCatalog = previous;
+    if (pinned != nullptr) {
+        pinned->pins.fetch_sub(1);
+    }
+}
+
+const ToppingCatalog& CatalogScope::catalog() const {
+    return *activeCatalog;
+}
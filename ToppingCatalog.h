@@ -0,0 +1,268 @@
+#ifndef TOPPINGCATALOG_H
+#define TOPPINGCATALOG_H
+
+#include "Money.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+class CatalogImage;
+class Topping;
+// Compact integer handle for a topping, assigned by the catalog at load time
+typedef int ToppingId;
+
+class CatalogSnapshot;
+
+// A predefined topping and its default price
+struct DefaultTopping {
+    const char* name;
+    int64_t cents;
+};
+
+// Add-ons priced once per pizza rather than per topping (see PizzaDecorator)
+enum PizzaModifier : uint8_t {
+    EXTRA_CHEESE = 0,
+    STUFFED_CRUST = 1
+};
+const size_t PIZZA_MODIFIER_COUNT = 2;
+
+// Catalog of all known toppings. Every topping gets a dense ID when it is
+// registered, and prices live in a flat array of cents indexed by that ID so
+// pricing never touches a string or a floating point number. Name lookups are only needed at the edges
+// (parsing user input, displaying the menu).
+//
+// A ToppingCatalog object is an immutable, versioned snapshot. Writers build
+// a new snapshot and publish it atomically; readers pin a snapshot
+// (CatalogSnapshot / CatalogScope) and never take a lock. IDs are stable
+// across reloads: a name keeps its ID, new names get new IDs, and toppings
+// missing from a reload keep their slot but are no longer available.
+//
+// A snapshot can also be backed by a mapped CatalogImage, in which case the
+// price table and name lookups read straight from the mapped pages.
+//
+// The catalog also owns one immutable, interned Topping per ID (see
+// getTopping). Recipes reference these flyweights instead of allocating
+// their own leaves; like IDs, they outlive every snapshot.
+//
+// Pizza modifiers (extra cheese, stuffed crust) are priced by the catalog
+// too, in a small table indexed by PizzaModifier.
+class ToppingCatalog {
+private:
+    std::vector<std::string> names;        // Indexed by ToppingId
+    std::vector<int64_t> prices;           // Cents, indexed by ToppingId
+    std::vector<char> available;           // Indexed by ToppingId
+    std::map<std::string, ToppingId> ids;  // Name -> ID, input parsing only
+    unsigned long version;
+
+    // Image the snapshot reads from, or nullptr for an in-memory snapshot
+    std::shared_ptr<const CatalogImage> image;
+
+    // Flat price table used for pricing (prices.data() or the image's table)
+    const int64_t* priceTable;
+    size_t toppingCount;
+    
+    // Interned toppings indexed by ToppingId (owned by the catalog, not the snapshot)
+    std::vector<const Topping*> leaves;
+
+    // Cents, indexed by PizzaModifier
+    int64_t modifierPrices[PIZZA_MODIFIER_COUNT];
+
+    // True if every predefined topping and modifier has its default price
+    bool defaultPrices;
+
+    // Number of readers currently holding this snapshot
+    mutable std::atomic<int> pins;
+
+    friend class CatalogSnapshot;
+    friend class CatalogScope;
+
+    // Snapshots are only created by the writer functions below
+    ToppingCatalog();
+    ToppingCatalog(const ToppingCatalog& previous, unsigned long newVersion);
+    ToppingCatalog(const std::shared_ptr<const CatalogImage>& catalogImage, unsigned long newVersion);
+    ToppingCatalog& operator=(const ToppingCatalog&) = delete;
+
+    // Add or update a topping while the snapshot is still private to a writer
+    ToppingId setTopping(const std::string& toppingName, Money toppingPrice);
+
+    // Mark every topping unavailable (start of a full reload)
+    void markAllUnavailable();
+
+    // Point the price table at the in-memory arrays after they changed and
+    // intern a Topping for every new ID
+    void syncTables();
+
+    // The most recently published snapshot
+    static std::atomic<const ToppingCatalog*>& published();
+
+    // Swap in a new snapshot and free retired ones that are no longer pinned
+    static void publish(ToppingCatalog* next);
+
+    // Pin the most recently published snapshot
+    static const ToppingCatalog* pinLatest();
+
+public:
+    // ID returned for names that are not in the catalog
+    static const ToppingId INVALID_ID = -1;
+
+    // Toppings every catalog starts with, in ID order (the first one gets
+    // ID 0). constexpr so recipes can be priced at compile time (StaticRecipe.h).
+    static constexpr DefaultTopping DEFAULT_TOPPINGS[] = {
+        // Base ingredients
+        {"Dough", 1000},
+        {"Tomato Sauce", 500},
+        {"Cheese", 1500},
+
+        // Toppings
+        {"Pepperoni", 2000},
+        {"Mushrooms", 1200},
+        {"Green Peppers", 1000},
+        {"Onions", 800},
+        {"Beef Sausage", 2500},
+        {"Salami", 2200},
+        {"Feta Cheese", 1800},
+        {"Olives", 1500}
+    };
+    static constexpr size_t DEFAULT_TOPPING_COUNT = sizeof(DEFAULT_TOPPINGS) / sizeof(DEFAULT_TOPPINGS[0]);
+
+    // Display names and default prices of the modifiers, indexed by PizzaModifier
+    static constexpr DefaultTopping DEFAULT_MODIFIERS[PIZZA_MODIFIER_COUNT] = {
+        {"Extra Cheese", 1200},
+        {"Stuffed Crust", 2000}
+    };
+
+    // ---- Reader side ----
+
+    // Pin the snapshot pricing should use on this thread (the active
+    // CatalogScope if there is one, otherwise the latest published catalog)
+    static CatalogSnapshot current();
+
+    // ---- Writer side (serialised internally, never blocks readers) ----
+
+    // Load "name,price" lines from a file and publish them as a new version.
+    // Returns false (and keeps the current catalog) if the file can't be parsed.
+    static bool loadFromFile(const std::string& path);
+
+    // Publish a new version with one topping added or repriced
+    static ToppingId registerTopping(const std::string& toppingName, Money toppingPrice);
+
+    // Publish a new version with a modifier repriced
+    static void registerModifier(PizzaModifier modifier, Money modifierPrice);
+
+    // Publish a new version containing only the predefined toppings and
+    // default modifier prices
+    static void resetToDefaults();
+
+    // Publish a snapshot that serves reads from a mapped catalog image.
+    // Fails if the image assigns different IDs to toppings already in use.
+    static bool installImage(const std::shared_ptr<const CatalogImage>& catalogImage);
+
+    // ---- Snapshot accessors ----
+
+    // Name -> ID lookup, returns INVALID_ID if the topping is unknown or unavailable
+    ToppingId findId(const std::string& toppingName) const;
+
+    // ID based accessors
+    bool isValidId(ToppingId id) const {
+        return id >= 0 && static_cast<size_t>(id) < toppingCount;
+    }
+    Money getPrice(ToppingId id) const {
+        return isValidId(id) ? Money::fromCents(priceTable[id]) : Money();
+    }
+    std::string getName(ToppingId id) const;
+    
+    // Name without copying it, valid while the snapshot is pinned
+    // (returns nullptr and length 0 for an unknown ID)
+    const char* getNameData(ToppingId id, size_t& length) const;
+
+    // Prices in cents indexed by ID (size() entries), valid while the
+    // snapshot is pinned. For bulk pricing (PriceBatch).
+    const int64_t* getPriceData() const {
+        return priceTable;
+    }
+    const Topping* getTopping(ToppingId id) const {
+        return isValidId(id) ? leaves[id] : nullptr;
+    }
+    bool isAvailable(ToppingId id) const;
+
+    // Modifier accessors (names never change, so they need no snapshot)
+    Money getModifierPrice(PizzaModifier modifier) const {
+        return modifier < PIZZA_MODIFIER_COUNT ? Money::fromCents(modifierPrices[modifier]) : Money();
+    }
+    static const char* getModifierName(PizzaModifier modifier) {
+        return modifier < PIZZA_MODIFIER_COUNT ? DEFAULT_MODIFIERS[modifier].name : "";
+    }
+
+    // Number of ID slots in this snapshot (IDs are 0 .. size()-1)
+    size_t size() const;
+
+    // Version number of this snapshot (increases with every publish)
+    unsigned long getVersion() const;
+
+    // True if every predefined topping and modifier still has its default
+    // price, so prices computed at compile time are still correct
+    bool hasDefaultPrices() const;
+
+    // Image backing this snapshot, or nullptr
+    std::shared_ptr<const CatalogImage> getImage() const;
+
+    // Name -> price view of the available toppings, for display
+    std::map<std::string, Money> toMap() const;
+};
+
+// Pinned reference to an immutable catalog snapshot. The snapshot can't be
+// freed while any CatalogSnapshot refers to it.
+class CatalogSnapshot {
+private:
+    const ToppingCatalog* catalog;
+
+public:
+    // Empty: pins nothing until a snapshot is assigned
+    CatalogSnapshot();
+
+    // Takes over one pin that the caller already holds on the catalog
+    explicit CatalogSnapshot(const ToppingCatalog* pinnedCatalog);
+    ~CatalogSnapshot();
+
+    CatalogSnapshot(const CatalogSnapshot& other);
+    CatalogSnapshot& operator=(const CatalogSnapshot& other);
+
+    // Drop the pin and become empty
+    void release();
+
+    explicit operator bool() const { return catalog != nullptr; }
+
+    const ToppingCatalog* get() const { return catalog; }
+    const ToppingCatalog* operator->() const { return catalog; }
+    const ToppingCatalog& operator*() const { return *catalog; }
+};
+
+// Makes one snapshot the active catalog for everything priced on this
+// thread while the scope is alive. Nested scopes without an explicit
+// snapshot reuse the outer one, so per-topping lookups inside a pricing
+// pass cost a thread-local read instead of an atomic pin.
+class CatalogScope {
+private:
+    const ToppingCatalog* previous;
+    const ToppingCatalog* pinned;  // Pin owned by this scope, or nullptr
+
+public:
+    // Reuse the active snapshot, or pin the latest one if there is none
+    CatalogScope();
+
+    // Price with the given snapshot until the scope ends
+    explicit CatalogScope(const CatalogSnapshot& snapshot);
+
+    ~CatalogScope();
+
+    CatalogScope(const CatalogScope&) = delete;
+    CatalogScope& operator=(const CatalogScope&) = delete;
+
+    // The snapshot that is active on this thread
+    const ToppingCatalog& catalog() const;
+};
+
+#endif
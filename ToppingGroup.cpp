@@ -1,37 +1,182 @@
 #include "ToppingGroup.h"
+#include "PizzaName.h"
 #include <iostream>
+#include <atomic>
+#include <cstdint>
 
-ToppingGroup::ToppingGroup(const std::string& groupName) {
+namespace {
+    // Catalog IDs of the toppings used by the predefined recipes, resolved once
+    struct RecipeIds {
+        ToppingId dough, tomatoSauce, cheese;
+        ToppingId pepperoni, mushrooms, greenPeppers, onions;
+        ToppingId beefSausage, salami, fetaCheese, olives;
+
+        RecipeIds() {
+            // IDs are stable across catalog reloads, so resolving them once is enough
+            CatalogSnapshot catalog = ToppingCatalog::current();
+            dough = catalog->findId("Dough");
+            tomatoSauce = catalog->findId("Tomato Sauce");
+            cheese = catalog->findId("Cheese");
+            pepperoni = catalog->findId("Pepperoni");
+            mushrooms = catalog->findId("Mushrooms");
+            greenPeppers = catalog->findId("Green Peppers");
+            onions = catalog->findId("Onions");
+            beefSausage = catalog->findId("Beef Sausage");
+            salami = catalog->findId("Salami");
+            fetaCheese = catalog->findId("Feta Cheese");
+            olives = catalog->findId("Olives");
+        }
+    };
+
+    const RecipeIds& recipeIds() {
+        static const RecipeIds ids;
+        return ids;
+    }
+}
+
+// Components of one or more groups. Copies share a list until one of them
+// changes; the last group to let go deletes it along with its components.
+struct ToppingGroup::ComponentList : public ResourceAllocated {
+    std::atomic<unsigned> references;
+    std::vector<PizzaComponent*> components;
+    
+    // Where the list and its components were allocated
+    MemoryResource* resource;
+    
+    // Group the nested groups' parent pointers refer to
+    ToppingGroup* owner;
+    
+    // Cached subtree total and the catalog version it belongs to (0 = not
+    // cached). Several threads may price the same list, so the pair is
+    // guarded by a sequence number: odd while a writer updates it.
+    std::atomic<unsigned> cacheSequence;
+    std::atomic<unsigned long> cachedVersion;
+    std::atomic<int64_t> cachedCents;
+    
+    // Cached subtree fingerprint (independent of the catalog version), with
+    // its own sequence number
+    std::atomic<unsigned> fingerprintSequence;
+    std::atomic<bool> fingerprintCached;
+    std::atomic<uint64_t> cachedFingerprintHigh;
+    std::atomic<uint64_t> cachedFingerprintLow;
+    
+    ComponentList(MemoryResource& memoryResource, ToppingGroup* listOwner)
+        : references(1), resource(&memoryResource), owner(listOwner),
+          cacheSequence(0), cachedVersion(0), cachedCents(0),
+          fingerprintSequence(0), fingerprintCached(false), cachedFingerprintHigh(0), cachedFingerprintLow(0) {
+    }
+    
+    ~ComponentList() {
+        for (PizzaComponent* component : components) {
+            if (!component->isShared()) {
+                delete component;  // This will call the proper destructor
+            }
+        }
+    }
+};
+
+ToppingGroup::ToppingGroup(const std::string& groupName, MemoryResource& memoryResource)
+    : list(new (memoryResource) ComponentList(memoryResource, this)), parent(nullptr), resource(&memoryResource) {
     this->name = groupName;
-    this->price = 0.0; // Will be calculated dynamically
+    this->price = Money(); // Will be calculated dynamically
 }
 
 ToppingGroup::~ToppingGroup() {
-    cleanup();
+    releaseList(list);
+}
+
+ToppingGroup::ToppingGroup(const ToppingGroup& other)
+    : PizzaComponent(other.price, other.name), list(nullptr), parent(nullptr), resource(&MemoryResource::heap()) {
+    shareFrom(other);
 }
 
-ToppingGroup::ToppingGroup(const ToppingGroup& other) : PizzaComponent(other.price, other.name) {
-    deepCopy(other);
+ToppingGroup::ToppingGroup(const ToppingGroup& other, MemoryResource& memoryResource)
+    : PizzaComponent(other.price, other.name), list(nullptr), parent(nullptr), resource(&memoryResource) {
+    shareFrom(other);
 }
 
 ToppingGroup& ToppingGroup::operator=(const ToppingGroup& other) {
     if (this != &other) {
-        cleanup();
-        deepCopy(other);
+        // Take the new list before letting go of ours (they may be the same)
+        ComponentList* previous = list;
+        shareFrom(other);
+        releaseList(previous);
+        
+        // The shared list keeps its cached total; only the groups above change
+        if (parent != nullptr) {
+            parent->invalidatePrice();
+        }
     }
     return *this;
 }
 
 void ToppingGroup::addComponent(PizzaComponent* component) {
     if (component != nullptr) {
-        components.push_back(component);
+        detach();
+        adopt(component);
+        invalidatePrice();
     }
 }
 
+void ToppingGroup::addTopping(ToppingId id, unsigned quantity) {
+    if (quantity == 0) {
+        return;
+    }
+    detach();
+    std::vector<PizzaComponent*>& components = list->components;
+    
+    // Count more portions of a topping the group already has
+    if (id != ToppingCatalog::INVALID_ID) {
+        for (PizzaComponent*& component : components) {
+            if (component->getKind() != TOPPING) {
+                continue;
+            }
+            const Topping* existing = static_cast<const Topping*>(component);
+            if (existing->getId() == id) {
+                PizzaComponent* counted = new (*resource) Topping(id, existing->getQuantity() + quantity);
+                if (!existing->isShared()) {
+                    delete existing;
+                }
+                component = counted;
+                invalidatePrice();
+                return;
+            }
+        }
+    }
+    
+    const Topping* leaf = quantity == 1 ? Topping::intern(id) : nullptr;
+    if (leaf != nullptr) {
+        // Interned toppings are immutable; the group only keeps a reference
+        components.push_back(const_cast<Topping*>(leaf));
+    } else {
+        components.push_back(new (*resource) Topping(id, quantity));
+    }
+    invalidatePrice();
+}
+
 bool ToppingGroup::removeComponent(PizzaComponent* component) {
-    for (auto it = components.begin(); it != components.end(); ++it) {
-        if (*it == component) {
-            components.erase(it);
+    const std::vector<PizzaComponent*>& current = list->components;
+    for (size_t i = 0; i < current.size(); ++i) {
+        if (current[i] == component) {
+            if (sharesComponents()) {
+                // The copies keep component; drop this group's copy of it
+                detach();
+                PizzaComponent* ownCopy = list->components[i];
+                list->components.erase(list->components.begin() + i);
+                if (!ownCopy->isShared()) {
+                    delete ownCopy;
+                }
+            } else {
+                detach();
+                list->components.erase(list->components.begin() + i);
+                if (component->getKind() == GROUP) {
+                    ToppingGroup* group = static_cast<ToppingGroup*>(component);
+                    if (group->parent == this) {
+                        group->parent = nullptr;
+                    }
+                }
+            }
+            invalidatePrice();
             return true;
         }
     }
@@ -39,143 +184,314 @@ bool ToppingGroup::removeComponent(PizzaComponent* component) {
 }
 
 std::string ToppingGroup::getName() const {
+    return renderName(*this);
+}
+
+void ToppingGroup::writeName(NameWriter& out) const {
+    const std::vector<PizzaComponent*>& components = list->components;
+    out.append(name);
     if (components.empty()) {
-        return name;
+        return;
     }
     
-    std::string result = name + " (";
-    
+    out.append(" (");
     for (size_t i = 0; i < components.size(); ++i) {
-        result += components[i]->getName();
+        components[i]->writeName(out);
         if (i < components.size() - 1) {
-            result += ", ";
+            out.append(", ");
         }
     }
-    
-    result += ")";
-    return result;
+    out.append(")");
 }
 
-double ToppingGroup::getPrice() const {
-    double totalPrice = 0.0;
+Money ToppingGroup::getPrice() const {
+    // Pin one catalog snapshot for the whole subtree
+    CatalogScope scope;
+    unsigned long catalogVersion = scope.catalog().getVersion();
+    Money totalPrice;
+    if (readCachedPrice(catalogVersion, totalPrice)) {
+        return totalPrice;
+    }
     
-    for (const auto& component : components) {
+    for (const auto& component : list->components) {
         totalPrice += component->getPrice();
     }
     
+    storeCachedPrice(catalogVersion, totalPrice);
     return totalPrice;
 }
 
-const std::vector<PizzaComponent*>& ToppingGroup::getComponents() const {
-    return components;
+PizzaFingerprint ToppingGroup::getFingerprint() const {
+    PizzaFingerprint fingerprint;
+    if (readCachedFingerprint(fingerprint)) {
+        return fingerprint;
+    }
+    
+    // The group itself adds nothing: only what is on the pizza counts
+    for (const auto& component : list->components) {
+        fingerprint += component->getFingerprint();
+    }
+    
+    storeCachedFingerprint(fingerprint);
+    return fingerprint;
+}
+
+PizzaComponent::Kind ToppingGroup::getKind() const {
+    return GROUP;
+}
+
+PizzaComponent* ToppingGroup::cloneInto(MemoryResource& resource) const {
+    return new (resource) ToppingGroup(*this, resource);
+}
+
+const std::string& ToppingGroup::getGroupName() const {
+    return name;
+}
+
+MemoryResource& ToppingGroup::getResource() const {
+    return *resource;
+}
+
+ToppingGroup::ComponentView ToppingGroup::getComponents() const {
+    return ComponentView(list->components);
+}
+
+const std::vector<PizzaComponent*>& ToppingGroup::getComponents() {
+    detach();
+    return list->components;
+}
+
+bool ToppingGroup::sharesComponents() const {
+    return list->references.load() > 1;
 }
 
 void ToppingGroup::clearComponents() {
-    cleanup();
-    components.clear();
+    // Start over with an empty list (copies sharing the old one keep it)
+    releaseList(list);
+    list = new (*resource) ComponentList(*resource, this);
+    invalidatePrice();
 }
 
 bool ToppingGroup::isEmpty() const {
-    return components.empty();
+    return list->components.empty();
 }
 
 size_t ToppingGroup::getComponentCount() const {
-    return components.size();
+    return list->components.size();
 }
 
-void ToppingGroup::deepCopy(const ToppingGroup& other) {
+void ToppingGroup::shareFrom(const ToppingGroup& other) {
     this->name = other.name;
     this->price = other.price;
     
-    // Deep copy all components
-    for (const auto& component : other.components) {
-        // Check if it's a Topping or ToppingGroup
-        Topping* topping = dynamic_cast<Topping*>(component);
-        if (topping) {
-            // Create a new Topping
-            this->components.push_back(new Topping(topping->getName()));
-        } else {
-            ToppingGroup* group = dynamic_cast<ToppingGroup*>(component);
-            if (group) {
-                // Create a new ToppingGroup
-                this->components.push_back(new ToppingGroup(*group));
+    // A list on the heap or in our own resource lives as long as its last
+    // group; one in another arena dies with that arena, so copy it instead
+    MemoryResource* source = other.list->resource;
+    if (source == &MemoryResource::heap() || source == resource) {
+        other.list->references.fetch_add(1);
+        list = other.list;
+    } else {
+        list = copyComponents(*other.list);
+    }
+}
+
+void ToppingGroup::detach() {
+    if (sharesComponents()) {
+        ComponentList* shared = list;
+        list = copyComponents(*shared);
+        releaseList(shared);  // The copies may have let go of it meanwhile
+    } else if (list->owner != this) {
+        // Inherited from a copy that has since gone away: claim the nested groups
+        for (PizzaComponent* component : list->components) {
+            if (component->getKind() == GROUP) {
+                static_cast<ToppingGroup*>(component)->parent = this;
             }
         }
+        list->owner = this;
+    }
+}
+
+ToppingGroup::ComponentList* ToppingGroup::copyComponents(const ComponentList& source) {
+    ComponentList* copy = new (*resource) ComponentList(*resource, this);
+    copy->components.reserve(source.components.size());
+    
+    for (const auto& component : source.components) {
+        // Shared toppings are referenced, not copied
+        if (component->isShared()) {
+            copy->components.push_back(component);
+            continue;
+        }
+        
+        // Toppings keep their catalog ID; nested groups share their own
+        // lists until they change
+        PizzaComponent* clone = component->cloneInto(*resource);
+        if (clone->getKind() == GROUP) {
+            static_cast<ToppingGroup*>(clone)->parent = this;
+        }
+        copy->components.push_back(clone);
     }
+    return copy;
 }
 
-void ToppingGroup::cleanup() {
-    for (auto& component : components) {
-        if (component != nullptr) {
-            delete component;  // This will call the proper destructor
-            component = nullptr;
+void ToppingGroup::releaseList(ComponentList* released) {
+    if (released->owner == this && released->references.load() > 1) {
+        // The copies keep the list, so its nested groups must not point here
+        for (PizzaComponent* component : released->components) {
+            if (component->getKind() == GROUP) {
+                static_cast<ToppingGroup*>(component)->parent = nullptr;
+            }
         }
+        released->owner = nullptr;
+    }
+    if (released->references.fetch_sub(1) == 1) {
+        delete released;
+    }
+}
+
+void ToppingGroup::adopt(PizzaComponent* component) {
+    if (component->getKind() == GROUP) {
+        static_cast<ToppingGroup*>(component)->parent = this;
+    }
+    list->components.push_back(component);
+}
+
+void ToppingGroup::invalidatePrice() {
+    // Callers have exclusive access while changing components, so no reader
+    // can be inside the sequence check here
+    for (ToppingGroup* group = this; group != nullptr; group = group->parent) {
+        group->list->cachedVersion = 0;
+        group->list->fingerprintCached = false;
     }
-    components.clear();  // Clear the vector
+}
+
+bool ToppingGroup::readCachedPrice(unsigned long catalogVersion, Money& total) const {
+    unsigned before = list->cacheSequence;
+    if (before & 1) {
+        return false;
+    }
+    unsigned long version = list->cachedVersion;
+    int64_t cents = list->cachedCents;
+    if (list->cacheSequence != before || version != catalogVersion) {
+        return false;
+    }
+    total = Money::fromCents(cents);
+    return true;
+}
+
+void ToppingGroup::storeCachedPrice(unsigned long catalogVersion, Money total) const {
+    unsigned before = list->cacheSequence;
+    if ((before & 1) || !list->cacheSequence.compare_exchange_strong(before, before + 1)) {
+        return;
+    }
+    list->cachedVersion = catalogVersion;
+    list->cachedCents = total.getCents();
+    list->cacheSequence = before + 2;
+}
+
+bool ToppingGroup::readCachedFingerprint(PizzaFingerprint& fingerprint) const {
+    unsigned before = list->fingerprintSequence;
+    if (before & 1) {
+        return false;
+    }
+    bool cached = list->fingerprintCached;
+    uint64_t high = list->cachedFingerprintHigh;
+    uint64_t low = list->cachedFingerprintLow;
+    if (list->fingerprintSequence != before || !cached) {
+        return false;
+    }
+    fingerprint = PizzaFingerprint(high, low);
+    return true;
+}
+
+void ToppingGroup::storeCachedFingerprint(const PizzaFingerprint& fingerprint) const {
+    unsigned before = list->fingerprintSequence;
+    if ((before & 1) || !list->fingerprintSequence.compare_exchange_strong(before, before + 1)) {
+        return;
+    }
+    list->cachedFingerprintHigh = fingerprint.high;
+    list->cachedFingerprintLow = fingerprint.low;
+    list->fingerprintCached = true;
+    list->fingerprintSequence = before + 2;
 }
 
 // Helper method to create base pizza components
-ToppingGroup* ToppingGroup::createBasePizza() {
-    ToppingGroup* base = new ToppingGroup("Base");
-    base->addComponent(new Topping("Dough"));
-    base->addComponent(new Topping("Tomato Sauce"));
-    base->addComponent(new Topping("Cheese"));
+ToppingGroup* ToppingGroup::createBasePizza(MemoryResource& memoryResource) {
+    ToppingGroup* base = new (memoryResource) ToppingGroup("Base", memoryResource);
+    base->addTopping(recipeIds().dough);
+    base->addTopping(recipeIds().tomatoSauce);
+    base->addTopping(recipeIds().cheese);
     return base;
 }
 
 // Static factory methods for predefined pizzas
-ToppingGroup* ToppingGroup::createPepperoniPizza() {
-    ToppingGroup* pizza = new ToppingGroup("Pepperoni");
+ToppingGroup* ToppingGroup::createPepperoniPizza(MemoryResource& memoryResource) {
+    ToppingGroup* pizza = new (memoryResource) ToppingGroup("Pepperoni", memoryResource);
     
     // Add base components
-    ToppingGroup* base = createBasePizza();
+    ToppingGroup* base = createBasePizza(memoryResource);
     pizza->addComponent(base);
     
     // Add pepperoni topping
-    pizza->addComponent(new Topping("Pepperoni"));
+    pizza->addTopping(recipeIds().pepperoni);
     
     return pizza;
 }
 
-ToppingGroup* ToppingGroup::createVegetarianPizza() {
-    ToppingGroup* pizza = new ToppingGroup("Vegetarian");
+ToppingGroup* ToppingGroup::createVegetarianPizza(MemoryResource& memoryResource) {
+    ToppingGroup* pizza = new (memoryResource) ToppingGroup("Vegetarian", memoryResource);
     
     // Add base components
-    ToppingGroup* base = createBasePizza();
+    ToppingGroup* base = createBasePizza(memoryResource);
     pizza->addComponent(base);
     
     // Add vegetarian toppings
-    pizza->addComponent(new Topping("Mushrooms"));
-    pizza->addComponent(new Topping("Green Peppers"));
-    pizza->addComponent(new Topping("Onions"));
+    pizza->addTopping(recipeIds().mushrooms);
+    pizza->addTopping(recipeIds().greenPeppers);
+    pizza->addTopping(recipeIds().onions);
     
     return pizza;
 }
 
-ToppingGroup* ToppingGroup::createMeatLoversPizza() {
-    ToppingGroup* pizza = new ToppingGroup("Meat Lovers");
+ToppingGroup* ToppingGroup::createMeatLoversPizza(MemoryResource& memoryResource) {
+    ToppingGroup* pizza = new (memoryResource) ToppingGroup("Meat Lovers", memoryResource);
     
     // Start with a Pepperoni pizza (composition)
-    ToppingGroup* pepperoniBase = createPepperoniPizza();
+    ToppingGroup* pepperoniBase = createPepperoniPizza(memoryResource);
     pizza->addComponent(pepperoniBase);
     
     // Add additional meat toppings
-    pizza->addComponent(new Topping("Beef Sausage"));
-    pizza->addComponent(new Topping("Salami"));
+    pizza->addTopping(recipeIds().beefSausage);
+    pizza->addTopping(recipeIds().salami);
     
     return pizza;
 }
 
-ToppingGroup* ToppingGroup::createVegetarianDeluxePizza() {
-    ToppingGroup* pizza = new ToppingGroup("Vegetarian Deluxe");
+ToppingGroup* ToppingGroup::createVegetarianDeluxePizza(MemoryResource& memoryResource) {
+    ToppingGroup* pizza = new (memoryResource) ToppingGroup("Vegetarian Deluxe", memoryResource);
     
     // Start with a Vegetarian pizza (composition)
-    ToppingGroup* vegetarianBase = createVegetarianPizza();
+    ToppingGroup* vegetarianBase = createVegetarianPizza(memoryResource);
     pizza->addComponent(vegetarianBase);
     
     // Add additional vegetarian toppings
-    pizza->addComponent(new Topping("Feta Cheese"));
-    pizza->addComponent(new Topping("Olives"));
+    pizza->addTopping(recipeIds().fetaCheese);
+    pizza->addTopping(recipeIds().olives);
+    
+    return pizza;
+}
+
+ToppingGroup* ToppingGroup::createCustomPizza(const std::vector<ToppingId>& toppingIds, MemoryResource& memoryResource) {
+    ToppingGroup* pizza = new (memoryResource) ToppingGroup("Custom Pizza", memoryResource);
+    
+    // Add base components
+    ToppingGroup* base = createBasePizza(memoryResource);
+    pizza->addComponent(base);
+    
+    // Add custom toppings (IDs are already validated by the caller; repeats
+    // are counted on one node)
+    for (ToppingId id : toppingIds) {
+        pizza->addTopping(id);
+    }
     
     return pizza;
 }
\ No newline at end of file
@@ -6,35 +6,116 @@
 #include <vector>
 #include <string>
 
+// Composite of toppings and nested groups. Each group caches its subtree
+// total for the catalog version it was priced under, and its fingerprint;
+// changing the group's components invalidates the caches of the group and of
+// every group above it, so repeated getPrice and getFingerprint calls are
+// O(1) and a change only recomputes the groups on its path to the root. Components must not be changed while
+// other threads are pricing the group.
+//
+// Copies share their component list (and its cached total) by reference count
+// until one of them is changed, so copying a group costs the same whatever its
+// depth. Changing a group first gives it a private list: its toppings are
+// copied and its nested groups become copies that share their own lists in
+// turn. Component pointers taken before a copy keep referring to the list the
+// copies share, so get them again from the group you mean to change.
 class ToppingGroup : public PizzaComponent {
+public:
+    // Read-only view of a group's components. The pointers come out const,
+    // so a list the group shares with copies can't be changed through it.
+    class ComponentView {
+    private:
+        const std::vector<PizzaComponent*>* components;
+        
+    public:
+        class const_iterator {
+        private:
+            std::vector<PizzaComponent*>::const_iterator position;
+            
+        public:
+            explicit const_iterator(std::vector<PizzaComponent*>::const_iterator at) : position(at) {}
+            const PizzaComponent* operator*() const { return *position; }
+            const_iterator& operator++() { ++position; return *this; }
+            bool operator==(const const_iterator& other) const { return position == other.position; }
+            bool operator!=(const const_iterator& other) const { return position != other.position; }
+        };
+        
+        explicit ComponentView(const std::vector<PizzaComponent*>& list) : components(&list) {}
+        
+        const_iterator begin() const { return const_iterator(components->begin()); }
+        const_iterator end() const { return const_iterator(components->end()); }
+        size_t size() const { return components->size(); }
+        bool empty() const { return components->empty(); }
+        const PizzaComponent* operator[](size_t index) const { return (*components)[index]; }
+    };
+    
 private:
-    std::vector<PizzaComponent*> components;
+    // Reference-counted component list (defined in ToppingGroup.cpp)
+    struct ComponentList;
+    ComponentList* list;
+    
+    // Group this one was added to, or nullptr (used to propagate invalidation)
+    ToppingGroup* parent;
+    
+    // Where this group allocates the components it creates (copies, factories)
+    MemoryResource* resource;
 
 public:
-    // Constructor
-    ToppingGroup(const std::string& groupName);
+    // Constructor (components the group creates come from memoryResource)
+    ToppingGroup(const std::string& groupName, MemoryResource& memoryResource = MemoryResource::heap());
     
     // Destructor to clean up components
     virtual ~ToppingGroup();
     
-    // Copy constructor
+    // Copy constructor (the copy allocates on the heap)
     ToppingGroup(const ToppingGroup& other);
     
+    // Copy that allocates from memoryResource. The components are shared when
+    // they live on the heap or in memoryResource itself, and copied otherwise
+    // (a copy must not depend on another arena).
+    ToppingGroup(const ToppingGroup& other, MemoryResource& memoryResource);
+    
     // Assignment operator
     ToppingGroup& operator=(const ToppingGroup& other);
     
     // Add a component (topping or another group)
     void addComponent(PizzaComponent* component);
     
-    // Remove a component
+    // Add portions of a topping by catalog ID. A single portion references the
+    // catalog's interned topping; adding a topping the group already holds
+    // raises its count instead of adding another node.
+    void addTopping(ToppingId id, unsigned quantity = 1);
+    
+    // Remove a component. The caller owns it afterwards, unless the list was
+    // shared with a copy: then the copy keeps it and only this group drops it.
     bool removeComponent(PizzaComponent* component);
     
     // Override virtual methods
     std::string getName() const override;
-    double getPrice() const override;
+    void writeName(NameWriter& out) const override;
+    Money getPrice() const override;
+    PizzaFingerprint getFingerprint() const override;
+    Kind getKind() const override;
+    
+    // Copy that shares this group's components (see the copy constructors)
+    PizzaComponent* cloneInto(MemoryResource& resource) const override;
+    
+    // Get the group's own name (getName() renders the whole subtree)
+    const std::string& getGroupName() const;
+    
+    // Resource the group allocates its components from
+    MemoryResource& getResource() const;
+    
+    // Get all components for reading (shared components are owned by the
+    // catalog, never delete them)
+    ComponentView getComponents() const;
     
-    // Get all components
-    const std::vector<PizzaComponent*>& getComponents() const;
+    // Components for changing: gives the group a private list first and
+    // links its nested groups back to it
+    const std::vector<PizzaComponent*>& getComponents();
+    
+    // True while the component list is shared with a copy
+    bool sharesComponents() const;
     
     // Clear all components
     void clearComponents();
@@ -45,21 +126,51 @@ public:
     // Get component count
     size_t getComponentCount() const;
     
-    // Static factory methods for predefined pizzas
-    static ToppingGroup* createPepperoniPizza();
-    static ToppingGroup* createVegetarianPizza();
-    static ToppingGroup* createMeatLoversPizza();
-    static ToppingGroup* createVegetarianDeluxePizza();
+    // Static factory methods for predefined pizzas (every node comes from memoryResource)
+    static ToppingGroup* createPepperoniPizza(MemoryResource& memoryResource = MemoryResource::heap());
+    static ToppingGroup* createVegetarianPizza(MemoryResource& memoryResource = MemoryResource::heap());
+    static ToppingGroup* createMeatLoversPizza(MemoryResource& memoryResource = MemoryResource::heap());
+    static ToppingGroup* createVegetarianDeluxePizza(MemoryResource& memoryResource = MemoryResource::heap());
+    
+    // Factory for a custom pizza: base components plus the given toppings
+    // (repeated IDs become one topping with a count)
+    static ToppingGroup* createCustomPizza(const std::vector<ToppingId>& toppingIds,
+                                           MemoryResource& memoryResource = MemoryResource::heap());
     
 private:
-    // Helper method for deep copying
-    void deepCopy(const ToppingGroup& other);
+    // Take other's name and components (shared or copied, see the constructor)
+    void shareFrom(const ToppingGroup& other);
+    
+    // Make the component list private to this group before it changes
+    void detach();
+    
+    // New list holding copies of source's components, linked to this group
+    ComponentList* copyComponents(const ComponentList& source);
+    
+    // Drop one reference to a list (the last one deletes it). If the list
+    // outlives this group and its nested groups point here, they are
+    // unlinked until the next group to change the list claims them.
+    void releaseList(ComponentList* released);
+    
+    // Take a new child component (links child groups back to this group)
+    void adopt(PizzaComponent* component);
+    
+    // Drop the cached total and fingerprint of this group and of every group above it
+    void invalidatePrice();
+    
+    // Cached total for the given catalog version, if there is one
+    bool readCachedPrice(unsigned long catalogVersion, Money& total) const;
+    
+    // Remember the total for the given catalog version (skipped if another
+    // thread is updating the cache at the same time)
+    void storeCachedPrice(unsigned long catalogVersion, Money total) const;
     
-    // Helper method to clean up components
-    void cleanup();
+    // Cached fingerprint, if there is one, and remembering it (same rules as the total)
+    bool readCachedFingerprint(PizzaFingerprint& fingerprint) const;
+    void storeCachedFingerprint(const PizzaFingerprint& fingerprint) const;
     
     // Helper method to create base pizza components (dough, sauce, cheese)
-    static ToppingGroup* createBasePizza();
+    static ToppingGroup* createBasePizza(MemoryResource& memoryResource);
 };
 
 #endif
\ No newline at end of file
@@ -1,33 +1,33 @@
 #include "Website.h"
-#include <iostream>
 
 Website::Website(const std::string& name, const std::string& url): websiteName(name), websiteUrl(url){
 }
 
 void Website::update(const std::string& message){
     updates.push_back(message);
+    Document document(*outputSink);
     
-    std::cout << "\nWebsite Update: " << websiteName << std::endl;
-    std::cout << "Website automatically updated with: " << message << std::endl;
-    std::cout << "Update published at: " << websiteUrl << std::endl;
+    document << "\nWebsite Update: " << websiteName << '\n';
+    document << "Website automatically updated with: " << message << '\n';
+    document << "Update published at: " << websiteUrl << '\n';
     
     if(message.find("NEW PIZZA") != std::string::npos){
-        std::cout << "- Added to online menu with photos and descriptions" << std::endl;
-        std::cout << "- Updated homepage banner" << std::endl;
+        document << "- Added to online menu with photos and descriptions\n";
+        document << "- Updated homepage banner\n";
     } 
     
     else if(message.find("SPECIAL OFFER") != std::string::npos){
-        std::cout << "- Featured on specials page" << std::endl;
-        std::cout << "- Added popup notification for visitors" << std::endl;
-        std::cout << "- Social media posts scheduled" << std::endl;
+        document << "- Featured on specials page\n";
+        document << "- Added popup notification for visitors\n";
+        document << "- Social media posts scheduled\n";
     } 
     
     else if(message.find("REMOVED") != std::string::npos || message.find("ENDED") != std::string::npos){
-        std::cout << "- Removed from online menu" << std::endl;
-        std::cout << "- Updated availability status" << std::endl;
+        document << "- Removed from online menu\n";
+        document << "- Updated availability status\n";
     }
     
-    publishUpdate(message);
+    writePublished(document);
 }
 
 std::string Website::getWebsiteName() const{
@@ -46,24 +46,30 @@ void Website::clearUpdates(){
     updates.clear();
 }
 
-void Website::displayUpdates() const{
-    std::cout << "\n=== Website Updates for " << websiteName << " ===" << std::endl;
+void Website::displayUpdates(OutputSink& sink) const{
+    Document document(sink);
+    document << "\n=== Website Updates for " << websiteName << " ===\n";
 
     if(updates.empty()){
-        std::cout << "No recent updates." << std::endl;
+        document << "No recent updates.\n";
     } 
     
     else{
         for(size_t i = 0; i < updates.size(); ++i){
-            std::cout << (i + 1) << ". " << updates[i] << std::endl;
+            document << (i + 1) << ". " << updates[i] << '\n';
         }
     }
 
-    std::cout << "==========================================" << std::endl;
+    document << "==========================================\n";
 }
 
 void Website::publishUpdate(const std::string& update){
     (void)update;
-    std::cout << "Published to website backend database" << std::endl;
-    std::cout << "Cache cleared for updated pages" << std::endl;
-}
\ No newline at end of file
+    Document document(*outputSink);
+    writePublished(document);
+}
+
+void Website::writePublished(std::ostream& out){
+    out << "Published to website backend database\n";
+    out << "Cache cleared for updated pages\n";
+}
\ No newline at end of file
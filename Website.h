@@ -9,6 +9,9 @@ private:
     std::string websiteName;
     std::string websiteUrl;
     std::vector<std::string> updates;
+    
+    // Lines printed once an update is published
+    static void writePublished(std::ostream& out);
 
 public:
     Website(const std::string& name = "Romeo's Pizza Website", const std::string& url = "www.romeospizza.co.za");
@@ -20,8 +23,8 @@ public:
     
     std::vector<std::string> getUpdates() const;
     void clearUpdates();
-    void displayUpdates() const;
+    void displayUpdates(OutputSink& sink = OutputSink::console()) const;
     void publishUpdate(const std::string& update);
 };
 
-#endif
\ No newline at end of file
+#endif
\ No newline at end of file